@@ -21,6 +21,9 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "engine.h"
 
@@ -39,6 +42,11 @@ namespace Mixer
     void Quit();
 
     bool valid = false;
+
+    // cache holds one reference, every channel playing the chunk one more
+    std::unordered_map<int, std::shared_ptr<chunk_t>> chunks;
+    uint32_t chunks_bytes = 0;
+    std::vector<std::shared_ptr<chunk_t>> channels;
 }
 
 bool Mixer::isValid()
@@ -48,8 +56,16 @@ bool Mixer::isValid()
 
 #include "SDL_mixer.h"
 
+/* runs with the audio locked */
 void FreeChannel(int channel)
 {
+    // cached chunk: release the channel reference only
+    if (0 <= channel && static_cast<size_t>(channel) < Mixer::channels.size() && Mixer::channels[channel])
+    {
+        Mixer::channels[channel].reset();
+        return;
+    }
+
     Mixer::chunk_t* sample = Mix_GetChunk(channel);
     if (sample) Mix_FreeChunk(sample);
 }
@@ -88,6 +104,7 @@ void Mixer::Quit()
         return;
     Music::Reset();
     Reset();
+    ClearCache();
     valid = false;
     Mix_CloseAudio();
 }
@@ -153,6 +170,54 @@ int Mixer::Play(const u8* ptr, uint32_t size, int channel, bool loop)
     return Play(sample, channel, loop);
 }
 
+int Mixer::Play(int id, const u8* ptr, uint32_t size, int channel, bool loop)
+{
+    if (!valid)
+    {
+        return -1;
+    }
+
+    std::shared_ptr<chunk_t>& sample = chunks[id];
+
+    if (!sample)
+    {
+        if (!ptr)
+            return -1;
+        chunk_t* loaded = LoadWAV(ptr, size);
+        if (!loaded)
+            return -1;
+        sample = std::shared_ptr<chunk_t>(loaded, FreeChunk);
+        chunks_bytes += loaded->alen;
+    }
+
+    Mix_ChannelFinished(FreeChannel);
+
+    // FreeChannel of the same channel can not run between play and assign
+    SDL_LockAudio();
+    const int res = Play(sample.get(), channel, loop);
+    if (0 <= res)
+    {
+        if (channels.size() <= static_cast<size_t>(res)) channels.resize(res + 1);
+        channels[res] = sample;
+    }
+    SDL_UnlockAudio();
+
+    return res;
+}
+
+void Mixer::ClearCache()
+{
+    SDL_LockAudio();
+    chunks.clear();
+    chunks_bytes = 0;
+    SDL_UnlockAudio();
+}
+
+uint32_t Mixer::CacheBytes()
+{
+    return chunks_bytes;
+}
+
 u16 Mixer::MaxVolume()
 {
     return MIX_MAX_VOLUME;
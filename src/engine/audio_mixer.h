@@ -49,6 +49,15 @@ namespace Mixer
 
     int Play(const u8*, uint32_t, int = -1, bool = false);
 
+    // the chunk of id is decoded once and shared by every channel playing it
+    int Play(int id, const u8*, uint32_t, int = -1, bool = false);
+
+    // drops the cached chunks, a playing chunk is freed when its channel finishes
+    void ClearCache();
+
+    // decoded bytes of the cached chunks
+    uint32_t CacheBytes();
+
     void SetChannels(u8);
 
     u16 MaxVolume();
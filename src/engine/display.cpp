@@ -46,6 +46,7 @@ void Display::SetVideoMode(int w, int h, bool fullscreen)
 
     displaySurface.surface = SDL_SetVideoMode(w, h, 0, flags);
     Set(w, h, 32, false);
+    SetDirty();
 
     if (!surface)
         Error::Except(__FUNCTION__, SDL_GetError());
@@ -58,8 +59,67 @@ Size Display::GetSize() const
 
 void Display::Flip()
 {
-    this->Blit(displaySurface);
-    SDL_Flip(displaySurface.surface);
+    // double buffered video surfaces are flipped whole
+    if (dirty_all || (displaySurface.surface->flags & SDL_DOUBLEBUF))
+    {
+        this->Blit(displaySurface);
+        SDL_Flip(displaySurface.surface);
+    }
+    else if (!dirty.empty())
+    {
+        MergeDirty();
+
+        vector<SDL_Rect> rects(dirty.size());
+
+        for (size_t it = 0; it < dirty.size(); ++it)
+        {
+            this->Blit(dirty[it], dirty[it], displaySurface);
+            SDLRect(dirty[it], rects[it]);
+        }
+
+        SDL_UpdateRects(displaySurface.surface, rects.size(), &rects[0]);
+    }
+
+    dirty.clear();
+    dirty_all = false;
+}
+
+void Display::AddDirty(const Rect& rt)
+{
+    if (dirty_all) return;
+
+    const Rect area = Rect::Get(rt, Rect(Point(0, 0), GetSize()), true);
+
+    if (0 == area.w || 0 == area.h) return;
+
+    // too fragmented: the whole screen is cheaper
+    if (dirty.size() < 64)
+        dirty.push_back(area);
+    else
+        SetDirty();
+}
+
+void Display::SetDirty()
+{
+    dirty_all = true;
+    dirty.clear();
+}
+
+void Display::MergeDirty()
+{
+    // the overlapped or adjacent areas are joined into one
+    for (size_t it1 = 0; it1 < dirty.size(); ++it1)
+    {
+        for (size_t it2 = it1 + 1; it2 < dirty.size(); ++it2)
+        {
+            if (dirty[it1] & dirty[it2])
+            {
+                dirty[it1] = Rect::Get(dirty[it1], dirty[it2], false);
+                dirty.erase(dirty.begin() + it2);
+                it2 = it1;
+            }
+        }
+    }
 }
 
 int IsFullScreen(SDL_Surface* surface)
@@ -85,13 +145,14 @@ int SDL_ToggleFS(SDL_Surface* surface)
     return 1;
 }
 
-void Display::ToggleFullScreen() const
+void Display::ToggleFullScreen()
 {
     const int result = SDL_WM_ToggleFullScreen(surface);
     if (result == 0)
     {
         SDL_ToggleFS(surface);
     }
+    SetDirty();
 }
 
 void Display::SetCaption(const char* str)
@@ -21,6 +21,7 @@
  ***************************************************************************/
 #pragma once
 
+#include <vector>
 #include "surface.h"
 
 using namespace std;
@@ -44,11 +45,18 @@ public:
 
     static void SetIcons(Surface&);
 
+    /* presents the dirty areas only, or the whole screen */
     void Flip();
 
+    /* the writes to the display are marked by the Surface blits and fills */
+    void AddDirty(const Rect&);
+
+    /* the whole screen goes out on the next flip */
+    void SetDirty();
+
     void Clear() const;
 
-    void ToggleFullScreen() const;
+    void ToggleFullScreen();
 
     void Fade(int delay = 500);
 
@@ -70,5 +78,10 @@ protected:
 
     Surface displaySurface;
 
+    vector<Rect> dirty;
+    bool dirty_all = true;
+
+    void MergeDirty();
+
     Display();
 };
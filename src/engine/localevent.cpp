@@ -441,6 +441,10 @@ bool LocalEvent::HandleEvents(bool delay)
                         loop_delay = 1;
                     }
                 }
+
+                // restored window: repaint all
+                if (event.active.gain)
+                    Display::Get().SetDirty();
             }
             break;
 
@@ -0,0 +1,179 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <iostream>
+
+#include "system.h"
+#include "profiler.h"
+
+namespace Profiler
+{
+    bool enabled = false;
+}
+
+namespace
+{
+    using Profiler::Node;
+    using Clock = std::chrono::steady_clock;
+
+    Node root;
+    thread_local Node* current = nullptr;
+    Clock::time_point frame_start;
+    std::string report;
+    std::string output;
+
+    double Milliseconds(uint64_t usec)
+    {
+        return usec / 1000.0;
+    }
+
+    void SortNodes(Node& node)
+    {
+        std::stable_sort(node.children.begin(), node.children.end(),
+                         [](const Node& node1, const Node& node2) { return node1.usec > node2.usec; });
+
+        for (Node& child : node.children)
+            SortNodes(child);
+    }
+
+    void ReportText(std::ostringstream& os, const Node& node, int depth)
+    {
+        for (const Node& child : node.children)
+        {
+            os << std::string(2 * depth, ' ') << child.name << ": " << Milliseconds(child.usec) << " ms, " <<
+                child.calls << " calls" << std::endl;
+            ReportText(os, child, depth + 1);
+        }
+    }
+
+    void ReportCSV(std::ostringstream& os, const std::string& frame, const std::string& path, const Node& node)
+    {
+        for (const Node& child : node.children)
+        {
+            const std::string scope = path.empty() ? child.name : path + "/" + child.name;
+
+            os << '"' << frame << "\"," << scope << "," << child.calls << "," << Milliseconds(child.usec) << std::endl;
+            ReportCSV(os, frame, scope, child);
+        }
+    }
+
+    bool isCSV(const std::string& file)
+    {
+        return 4 <= file.size() && 0 == file.compare(file.size() - 4, 4, ".csv");
+    }
+}
+
+void Profiler::SetEnabled(bool f)
+{
+    enabled = f;
+    current = f ? &root : nullptr;
+    root.children.clear();
+    report.clear();
+    frame_start = Clock::now();
+}
+
+void Profiler::SetOutput(const std::string& file)
+{
+    output = file;
+
+    if (output.empty()) return;
+
+    std::ofstream fs(output.c_str(), std::ios::out | std::ios::trunc);
+    if (!fs)
+    {
+        H2ERROR("write error: " << output);
+        output.clear();
+    }
+    else if (isCSV(output))
+        fs << "frame,scope,calls,ms" << std::endl;
+}
+
+void Profiler::EndFrame(const std::string& title)
+{
+    // frames end between the timers only
+    if (!enabled || current != &root) return;
+
+    const Clock::time_point now = Clock::now();
+    root.usec = std::chrono::duration_cast<std::chrono::microseconds>(now - frame_start).count();
+    frame_start = now;
+    SortNodes(root);
+
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(1);
+    os << title << ": " << Milliseconds(root.usec) << " ms" << std::endl;
+    ReportText(os, root, 1);
+    report = os.str();
+
+    if (!output.empty())
+    {
+        std::ofstream fs(output.c_str(), std::ios::out | std::ios::app);
+
+        if (isCSV(output))
+        {
+            std::ostringstream csv;
+            csv << std::fixed << std::setprecision(3);
+            csv << '"' << title << "\",frame,1," << Milliseconds(root.usec) << std::endl;
+            ReportCSV(csv, title, "", root);
+            fs << csv.str();
+        }
+        else
+            fs << report;
+    }
+
+    root.children.clear();
+}
+
+const std::string& Profiler::GetReport()
+{
+    return report;
+}
+
+void Profiler::Scope::Start(const char* name)
+{
+    // not the measured thread
+    if (!current) return;
+
+    parent = current;
+
+    auto it = std::find_if(parent->children.begin(), parent->children.end(),
+                           [name](const Node& child) { return child.name == name; });
+
+    if (it == parent->children.end())
+    {
+        parent->children.emplace_back(name);
+        node = &parent->children.back();
+    }
+    else
+        node = &*it;
+
+    current = node;
+    start = Clock::now();
+}
+
+void Profiler::Scope::Stop()
+{
+    node->usec += std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    ++node->calls;
+    current = parent;
+}
@@ -0,0 +1,93 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include "types.h"
+
+/*
+ * scoped timers grouped by nesting into one tree per frame (a day rollover or a kingdom turn),
+ * only the thread which enabled the profiler is measured: timers in the worker threads do nothing
+ */
+namespace Profiler
+{
+    struct Node
+    {
+        explicit Node(const char* name = "") : name(name)
+        {
+        }
+
+        const char* name;
+        uint32_t calls = 0;
+        uint64_t usec = 0;
+        std::vector<Node> children;
+    };
+
+    extern bool enabled;
+
+    inline bool isEnabled()
+    {
+        return enabled;
+    }
+
+    // the calling thread becomes the measured one
+    void SetEnabled(bool);
+
+    // every frame is appended to the file: csv for the *.csv names, text otherwise, empty: no file
+    void SetOutput(const std::string&);
+
+    // closes the frame, outside of any timer
+    void EndFrame(const std::string& title);
+
+    // text of the last frame
+    const std::string& GetReport();
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char* name)
+        {
+            if (enabled) Start(name);
+        }
+
+        ~Scope()
+        {
+            if (node) Stop();
+        }
+
+        Scope(const Scope&) = delete;
+
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        void Start(const char*);
+
+        void Stop();
+
+        Node* node = nullptr;
+        Node* parent = nullptr;
+        std::chrono::steady_clock::time_point start;
+    };
+}
+
+#define PROFILE_SCOPE(name) const Profiler::Scope profile_scope(name)
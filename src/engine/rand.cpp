@@ -20,17 +20,135 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
-#include <cstdlib>
 #include <ctime>
+#include <algorithm>
+#include <cstdint>
 
 #include "system.h"
 #include "rand.h"
 #include <sstream>
 #include <iostream>
 
-void Rand::Init()
+namespace
 {
-    srand(static_cast<uint32_t>(time(nullptr)));
+    uint32_t seed = 0;
+
+    // shared streams are used by the main thread only
+    Rand::Generator streams[Rand::STREAMS];
+
+    thread_local int thread_stream = Rand::WORLD;
+
+    thread_local bool thread_private = false;
+
+    thread_local Rand::Generator thread_generator;
+
+    uint32_t Rotate(uint32_t value, int bits)
+    {
+        return (value << bits) | (value >> (32 - bits));
+    }
+
+    double Random()
+    {
+        Rand::Generator& generator = thread_private ? thread_generator : streams[thread_stream];
+
+        return generator.Next() / 4294967296.0;
+    }
+}
+
+Rand::Generator::Generator(uint32_t value)
+{
+    Seed(value);
+}
+
+void Rand::Generator::Seed(uint32_t value)
+{
+    // splitmix64 expands the seed, the state is never all zero
+    uint64_t mix = value;
+
+    for (uint32_t i = 0; i < 4; i += 2)
+    {
+        uint64_t z = (mix += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+
+        state[i] = static_cast<uint32_t>(z);
+        state[i + 1] = static_cast<uint32_t>(z >> 32);
+    }
+}
+
+uint32_t Rand::Generator::Next()
+{
+    const uint32_t result = Rotate(state[1] * 5, 7) * 9;
+    const uint32_t t = state[1] << 9;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = Rotate(state[3], 11);
+
+    return result;
+}
+
+void Rand::Init(uint32_t value)
+{
+    seed = value ? value : static_cast<uint32_t>(time(nullptr));
+
+    for (uint32_t stream = 0; stream < STREAMS; ++stream)
+        streams[stream].Seed(seed + stream * 0x9E3779B9u);
+}
+
+uint32_t Rand::GetSeed()
+{
+    return seed;
+}
+
+vector<uint32_t> Rand::GetState()
+{
+    vector<uint32_t> result;
+    result.reserve(STREAMS * 4);
+
+    for (const Generator& generator : streams)
+        result.insert(result.end(), generator.state, generator.state + 4);
+
+    return result;
+}
+
+void Rand::SetState(const vector<uint32_t>& state)
+{
+    if (state.size() != STREAMS * 4)
+    {
+        H2ERROR("invalid random state, size: " << state.size());
+        return;
+    }
+
+    for (uint32_t stream = 0; stream < STREAMS; ++stream)
+    {
+        const uint32_t* value = &state[stream * 4];
+
+        if (value[0] | value[1] | value[2] | value[3])
+            std::copy(value, value + 4, streams[stream].state);
+    }
+}
+
+Rand::Stream::Stream(int stream) : previous(thread_stream)
+{
+    thread_stream = stream;
+}
+
+Rand::Stream::~Stream()
+{
+    thread_stream = previous;
+}
+
+void Rand::SetThreadSeed(uint32_t value)
+{
+    thread_private = 0 != value;
+
+    if (thread_private)
+        thread_generator.Seed(value);
 }
 
 int32_t Rand::Get(int32_t min, int32_t max)
@@ -42,7 +160,7 @@ int32_t Rand::Get(int32_t min, int32_t max)
         return min + Get(max - min);
     }
 
-    return static_cast<uint32_t>((min + 1) * (rand() / (RAND_MAX + 1.0)));
+    return static_cast<uint32_t>((min + 1) * Random());
 }
 
 Rand::Queue::Queue(uint32_t size)
@@ -30,7 +30,52 @@ using namespace std;
 
 namespace Rand
 {
-    void Init();
+    /* xoshiro128** generator */
+    class Generator
+    {
+    public:
+        explicit Generator(uint32_t seed = 0);
+
+        void Seed(uint32_t);
+
+        uint32_t Next();
+
+        uint32_t state[4];
+    };
+
+    // independent streams, every subsystem replays the same sequence for the same seed
+    enum
+    {
+        WORLD,
+        BATTLE,
+        AI,
+        STREAMS
+    };
+
+    // seeds all streams, 0: seed from the current time
+    void Init(uint32_t seed = 0);
+
+    uint32_t GetSeed();
+
+    // streams state for the save files
+    vector<uint32_t> GetState();
+
+    void SetState(const vector<uint32_t>&);
+
+    // selects the stream of the calling thread until destruction
+    class Stream
+    {
+    public:
+        explicit Stream(int);
+
+        ~Stream();
+
+    private:
+        int previous;
+    };
+
+    // private generator of the calling thread for parallel simulations, 0 returns to the shared streams
+    void SetThreadSeed(uint32_t);
 
     int32_t Get(int32_t min, int32_t max = 0);
 
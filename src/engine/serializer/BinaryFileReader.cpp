@@ -1,6 +1,19 @@
 #include "BinaryFileReader.h"
 #include "gamedefs.h"
 #include <fstream>
+#include <algorithm>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MAPPED_FILE_POSIX
+#endif
 
 BinaryFileReader::BinaryFileReader()
     : _file(nullptr),
@@ -106,6 +119,98 @@ void BinaryFileReader::close()
     _file = nullptr;
 }
 
+MappedFile::MappedFile()
+    : _data(nullptr), _size(0), _mapped(false)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string& fileName)
+{
+    close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE)
+    {
+        const DWORD fileSize = GetFileSize(file, nullptr);
+        HANDLE mapping = fileSize && fileSize != INVALID_FILE_SIZE
+                             ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)
+                             : nullptr;
+        // the view keeps the mapping and the file open
+        if (mapping)
+        {
+            _data = static_cast<const u8*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+
+        if (_data)
+        {
+            _size = fileSize;
+            _mapped = true;
+            return true;
+        }
+    }
+#elif defined(MAPPED_FILE_POSIX)
+    const int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat st;
+        void* map = MAP_FAILED;
+        if (0 == fstat(fd, &st) && st.st_size > 0)
+            map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // the mapping keeps the file open
+        ::close(fd);
+
+        if (map != MAP_FAILED)
+        {
+            _data = static_cast<const u8*>(map);
+            _size = st.st_size;
+            _mapped = true;
+            return true;
+        }
+    }
+#endif
+
+    _buffer = FileUtils::readFileBytes(fileName);
+    _data = _buffer.data();
+    _size = _buffer.size();
+    return !_buffer.empty();
+}
+
+const u8* MappedFile::data() const
+{
+    return _data;
+}
+
+uint32_t MappedFile::size() const
+{
+    return _size;
+}
+
+void MappedFile::close()
+{
+    if (_mapped)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(_data);
+#elif defined(MAPPED_FILE_POSIX)
+        munmap(const_cast<u8*>(_data), _size);
+#endif
+    }
+
+    std::vector<u8>().swap(_buffer);
+    _data = nullptr;
+    _size = 0;
+    _mapped = false;
+}
+
 namespace FileUtils
 {
     std::vector<u8> readFileBytes(const std::string& fileName)
@@ -122,6 +227,24 @@ namespace FileUtils
         return result;
     }
 
+    std::vector<u8> readFileBytes(const std::string& fileName, uint32_t offset, uint32_t size)
+    {
+        std::vector<u8> result;
+        BinaryFileReader reader;
+        if (!reader.open(fileName, "rb"))
+        {
+            return result;
+        }
+        const uint32_t fileSize = reader.size();
+        if (offset >= fileSize)
+        {
+            return result;
+        }
+        reader.seek(offset);
+        result = reader.getRaw(std::min(size, fileSize - offset));
+        return result;
+    }
+
     bool Exists(const std::string& fileName)
     {
         std::ifstream infile(fileName);
@@ -41,10 +41,39 @@ public:
     void close();
 };
 
+/* read only mapping of a whole file, reads it to memory where mapping is not available */
+class MappedFile
+{
+    const u8* _data;
+    uint32_t _size;
+    bool _mapped;
+    std::vector<u8> _buffer;
+
+public:
+    MappedFile();
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& fileName);
+
+    const u8* data() const;
+
+    uint32_t size() const;
+
+    void close();
+};
+
 namespace FileUtils
 {
     std::vector<u8> readFileBytes(const std::string& fileName);
 
+    // at most size bytes from offset
+    std::vector<u8> readFileBytes(const std::string& fileName, uint32_t offset, uint32_t size);
+
     std::vector<std::string> readFileLines(const std::string& fileName);
     bool Exists(const std::string& fileName);
 
@@ -1,4 +1,5 @@
 #include "ByteVectorReader.h"
+#include <algorithm>
 #include "rect.h"
 
 namespace
@@ -12,7 +13,18 @@ namespace
 }
 
 ByteVectorReader::ByteVectorReader(const std::vector<u8>& data)
-    : _data(data), _pos(0)
+    : _data(data.data()), _size(data.size()), _pos(0)
+{
+}
+
+ByteVectorReader::ByteVectorReader(const std::vector<u8>& data, uint32_t offset, uint32_t size)
+    : _data(data.data() + std::min<size_t>(offset, data.size())),
+      _size(std::min<size_t>(size, data.size() - std::min<size_t>(offset, data.size()))), _pos(0)
+{
+}
+
+ByteVectorReader::ByteVectorReader(const u8* data, uint32_t size)
+    : _data(data), _size(size), _pos(0)
 {
 }
 
@@ -23,20 +35,20 @@ void ByteVectorReader::skip(uint32_t sz)
 
 uint32_t ByteVectorReader::Get8()
 {
-    const uint32_t result = _data[_pos];
+    const uint32_t result = _pos < _size ? _data[_pos] : 0;
     _pos++;
     return result;
 }
 
 uint32_t ByteVectorReader::getLE16()
 {
-    if (!Endian::isLittle)
+    if (!Endian::isLittle || _pos + 2 > _size)
     {
         uint32_t lo = Get8();
         uint32_t hi = Get8();
         return lo + (hi << 8);
     }
-    auto* resultPtr = reinterpret_cast<const uint16_t *>(_data.data() + _pos);
+    auto* resultPtr = reinterpret_cast<const uint16_t *>(_data + _pos);
     _pos += 2;
     const uint16_t result = *resultPtr;
     return result;
@@ -44,7 +56,7 @@ uint32_t ByteVectorReader::getLE16()
 
 uint32_t ByteVectorReader::getLE32()
 {
-    if (!Endian::isLittle)
+    if (!Endian::isLittle || _pos + 4 > _size)
     {
         auto llo = Get8();
         auto lhi = Get8();
@@ -55,7 +67,7 @@ uint32_t ByteVectorReader::getLE32()
         uint32_t result = lo + hi;
         return result;
     }
-    auto* resultPtr = reinterpret_cast<const uint32_t *>(_data.data() + _pos);
+    auto* resultPtr = reinterpret_cast<const uint32_t *>(_data + _pos);
     _pos += 4;
     const auto result = *resultPtr;
     return result;
@@ -75,13 +87,13 @@ uint32_t ByteVectorReader::get32()
 
 uint32_t ByteVectorReader::getBE16()
 {
-    if (Endian::isLittle)
+    if (Endian::isLittle || _pos + 2 > _size)
     {
         const uint32_t lo = Get8();
         const uint32_t hi = Get8();
         return hi + (lo << 8);
     }
-    auto* resultPtr = reinterpret_cast<const uint16_t *>(_data.data() + _pos);
+    auto* resultPtr = reinterpret_cast<const uint16_t *>(_data + _pos);
     _pos += 2;
     uint16_t result = *resultPtr;
     return result;
@@ -89,7 +101,7 @@ uint32_t ByteVectorReader::getBE16()
 
 uint32_t ByteVectorReader::getBE32()
 {
-    if (Endian::isLittle)
+    if (Endian::isLittle || _pos + 4 > _size)
     {
         const uint32_t lo1 = Get8();
         const uint32_t hi1 = Get8();
@@ -99,7 +111,7 @@ uint32_t ByteVectorReader::getBE32()
         const uint32_t hi = hi2 + (lo2 << 8);
         return hi + lo;
     }
-    auto* resultPtr = reinterpret_cast<const uint32_t *>(_data.data() + _pos);
+    auto* resultPtr = reinterpret_cast<const uint32_t *>(_data + _pos);
     _pos += 4;
     uint32_t result = *resultPtr;
     return result;
@@ -107,7 +119,7 @@ uint32_t ByteVectorReader::getBE32()
 
 uint32_t ByteVectorReader::size() const
 {
-    return _data.size();
+    return _size;
 }
 
 void ByteVectorReader::seek(uint32_t pos)
@@ -127,15 +139,15 @@ uint32_t ByteVectorReader::tell() const
 
 std::vector<u8> ByteVectorReader::getRaw(size_t sizeblock)
 {
+    const size_t available = _pos < _size ? _size - _pos : 0;
     if (sizeblock == 0)
     {
-        sizeblock = size() - tell();
+        sizeblock = available;
     }
-    const auto start = _data.begin() + _pos;
-    const auto end_pos = start + sizeblock;
+    const u8* start = _data + std::min(_pos, _size);
 
     std::vector<u8> result;
-    result.assign(start, end_pos);
+    result.assign(start, start + std::min(sizeblock, available));
     _pos += sizeblock;
     return result;
 }
@@ -189,8 +201,8 @@ ByteVectorReader& operator>>(ByteVectorReader& msg, std::string& v)
 std::string ByteVectorReader::readString()
 {
     const uint32_t size = get32();
-    const auto* vData = reinterpret_cast<const char*>(_data.data() + _pos);
-    std::string v(vData, size);
+    const auto* vData = reinterpret_cast<const char*>(_data + std::min(_pos, _size));
+    std::string v(vData, _pos < _size ? std::min(size, _size - _pos) : 0);
     _pos += size;
     return v;
 }
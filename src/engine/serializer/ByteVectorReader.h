@@ -9,15 +9,22 @@
 
 struct Point;
 
+/* reads a view over bytes owned by the caller, reads past the end return zeroes */
 class ByteVectorReader
 {
-    const std::vector<u8>& _data;
-    int _pos;
+    const u8* _data;
+    uint32_t _size;
+    uint32_t _pos;
     bool _isBigEndian = false;
 
 public:
     explicit ByteVectorReader(const std::vector<u8>& data);
 
+    // size bytes from offset of data
+    ByteVectorReader(const std::vector<u8>& data, uint32_t offset, uint32_t size);
+
+    ByteVectorReader(const u8* data, uint32_t size);
+
     void skip(uint32_t sz);
 
     uint32_t Get8();
@@ -27,6 +27,7 @@
 #include <cstring>
 #include <memory>
 #include "surface.h"
+#include "display.h"
 #include "error.h"
 #include "system.h"
 
@@ -670,6 +671,10 @@ void Surface::BlitAlpha(const Rect& srt, const Point& dpt, Surface& dst) const
             dst.SetPixel4(dpt.x + x, dpt.y + y, finalPix);
         }
     }
+
+    Display& display = Display::Get();
+    if (&dst == &display)
+        display.AddDirty(Rect(dpt, srt.w, srt.h));
 }
 
 void Surface::Blit(const Rect& srt, const Point& dpt, Surface& dst) const
@@ -687,6 +692,11 @@ void Surface::Blit(const Rect& srt, const Point& dpt, Surface& dst) const
     }
     else
         SDL_BlitSurface(surface, &srcrect, dst.surface, &dstrect);
+
+    // dstrect is clipped by the blit
+    Display& display = Display::Get();
+    if (&dst == &display)
+        display.AddDirty(Rect(dstrect));
 }
 
 void Surface::Blit(Surface& dst) const
@@ -1074,6 +1084,10 @@ void Surface::FillRect(const Rect& rect, const RGBA& col) const
     SDL_Rect dstrect;
     SDLRect(rect, dstrect);
     SDL_FillRect(surface, &dstrect, MapRGB(col));
+
+    Display& display = Display::Get();
+    if (this == &display)
+        display.AddDirty(rect);
 }
 
 namespace
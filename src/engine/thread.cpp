@@ -109,6 +109,40 @@ bool Mutex::Unlock() const
     return mutex != nullptr && 0 == SDL_mutexV(mutex);
 }
 
+Semaphore::Semaphore(bool init) : sem(init ? SDL_CreateSemaphore(0) : nullptr)
+{
+}
+
+Semaphore::Semaphore(const Semaphore&) : sem(nullptr)
+{
+}
+
+Semaphore::~Semaphore()
+{
+    if (sem) SDL_DestroySemaphore(sem);
+}
+
+Semaphore& Semaphore::operator=(const Semaphore&)
+{
+    return *this;
+}
+
+void Semaphore::Create()
+{
+    if (sem) SDL_DestroySemaphore(sem);
+    sem = SDL_CreateSemaphore(0);
+}
+
+bool Semaphore::Post() const
+{
+    return sem != nullptr && 0 == SDL_SemPost(sem);
+}
+
+bool Semaphore::Wait() const
+{
+    return sem != nullptr && 0 == SDL_SemWait(sem);
+}
+
 Timer::Timer() : id(nullptr)
 {
 }
@@ -80,6 +80,28 @@ namespace SDL
         SDL_mutex* mutex;
     };
 
+    class Semaphore
+    {
+    public:
+        explicit Semaphore(bool init = false);
+
+        Semaphore(const Semaphore&);
+
+        ~Semaphore();
+
+        Semaphore& operator=(const Semaphore&);
+
+        void Create();
+
+        bool Post() const;
+
+        bool Wait() const;
+
+    private:
+
+        SDL_sem* sem;
+    };
+
     class Timer
     {
     public:
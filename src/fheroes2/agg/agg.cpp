@@ -24,6 +24,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -42,6 +43,7 @@
 #include "m82.h"
 #include "system.h"
 #include "tools.h"
+#include "profiler.h"
 #include "palette_h2.h"
 #include "til.h"
 #include "xmi.h"
@@ -68,6 +70,7 @@ namespace AGG
 {
     File heroes2_agg;
     File heroes2x_agg;
+    Atlas atlas;
 
     vector<icn_cache_t> icn_cache;
     vector<til_cache_t> til_cache;
@@ -79,6 +82,11 @@ namespace AGG
 
     bool memlimit_usage = true;
 
+    vector<lru_node_t> lru_nodes(1);
+    uint32_t lru_free = 0;
+    cache_stats_t cache_stats;
+    prefetch_pool_t prefetch;
+
 
     up<FontTTF[]> fonts; /* small, medium */
 
@@ -120,13 +128,67 @@ namespace AGG
 
     bool CheckMemoryLimit();
 
-    uint32_t ClearFreeObjects();
+    void CacheUnlink(uint32_t);
+
+    void CachePushFront(uint32_t);
+
+    void CacheTouch(uint32_t);
+
+    void CacheInsert(uint32_t& slot, int type, uint32_t id, uint32_t index, uint32_t bytes);
+
+    void CacheRegister(uint32_t& slot, int type, uint32_t id, uint32_t index, uint32_t bytes);
+
+    void CacheRegisterICN(int icn);
+
+    bool CacheEvict(const lru_node_t&);
+
+    uint32_t& CacheSlot(const lru_node_t&);
 
     bool ReadDataDir();
 
-    vector<u8> ReadICNChunk(int icn, uint32_t);
+    string AtlasName();
+
+    void ReadICNFrames(const Chunk&, vector<icn_frame_t>&);
+
+    /* writes the decoded pixels into the frame surfaces, the RLE and the atlas paths share it */
+    class ICNFrameWriter
+    {
+    public:
+        ICNFrameWriter(ICNSprite&, const icn_frame_t&);
+
+        void operator()(uint32_t x, uint32_t y, u8 index, u8 type);
+
+        void Finish(int icn);
+
+    private:
+        ICNSprite& res;
+        uint32_t width;
+        uint32_t height;
+        bool shadow;
+    };
+
+    template <typename Put>
+    void DecodeICNRLE(const Chunk&, const icn_frame_t&, Put& put);
+
+    ICNSprite RenderICNFrame(int icn, const Chunk&, const icn_frame_t&);
+
+    ICNSprite RenderICNFrame(int icn, const u8* pixels, const u8* mask, const icn_frame_t&);
+
+    void DecodeICNFrame(const Chunk&, const icn_frame_t&, vector<u8>& pixels, vector<u8>& mask);
+
+    uint32_t ExtICNCount(int icn);
+
+    int PrefetchWorker(void*);
+
+    bool PrefetchStart();
+
+    void PrefetchStop();
 
-    vector<u8> ReadChunk(const string&);
+    void PrefetchCollect();
+
+    const icn_cache_t& GetICNFrames(int icn, uint32_t);
+
+    Chunk ReadChunk(const string&);
 }
 
 sp<Sprite> AGG::ICNSprite::CreateSprite(bool reflect, bool shadow) const
@@ -145,110 +207,213 @@ bool AGG::ICNSprite::isValid() const
     return first.isValid();
 }
 
-uint32_t AGG::ClearFreeObjects()
+void AGG::CacheUnlink(uint32_t id)
 {
-    uint32_t total = 0;
+    const lru_node_t& node = lru_nodes[id];
 
-    // wav cache
-    for (auto& it : wav_cache)
-        total += it.second.size();
+    lru_nodes[node.prev].next = node.next;
+    lru_nodes[node.next].prev = node.prev;
+}
 
-    total = 0;
+void AGG::CachePushFront(uint32_t id)
+{
+    lru_node_t& node = lru_nodes[id];
 
-    // mus cache
-    for (auto& it : mid_cache)
-        total += it.second.size();
+    node.prev = 0;
+    node.next = lru_nodes[0].next;
+    lru_nodes[node.next].prev = id;
+    lru_nodes[0].next = id;
+}
 
-    total = 0;
+/* cache hit: the surface becomes the most recently used, 0: not tracked */
+void AGG::CacheTouch(uint32_t id)
+{
+    ++cache_stats.hits;
 
-    // fnt cache
-    for (auto& it : fnt_cache)
+    if (id && lru_nodes[0].next != id)
     {
-        total += it.second.sfs[0].GetMemoryUsage();
-        total += it.second.sfs[1].GetMemoryUsage();
-        total += it.second.sfs[2].GetMemoryUsage();
-        total += it.second.sfs[3].GetMemoryUsage();
+        CacheUnlink(id);
+        CachePushFront(id);
     }
+}
 
-    total = 0;
+/* cache miss: a decoded surface, slot of its owner keeps the node */
+void AGG::CacheInsert(uint32_t& slot, int type, uint32_t id, uint32_t index, uint32_t bytes)
+{
+    ++cache_stats.misses;
+    CacheRegister(slot, type, id, index, bytes);
+}
 
-    // til cache
-    for (auto& tils : til_cache)
+/* a surface accounted without a miss */
+void AGG::CacheRegister(uint32_t& slot, int type, uint32_t id, uint32_t index, uint32_t bytes)
+{
+    if (slot)
     {
-        for (uint32_t jj = 0; jj < tils.count; ++jj)
-            if (tils.sprites)
-                total += tils.sprites[jj].GetMemoryUsage();
+        lru_node_t& node = lru_nodes[slot];
+        cache_stats.bytes = cache_stats.bytes - node.bytes + bytes;
+        cache_stats.types[node.type] = cache_stats.types[node.type] - node.bytes + bytes;
+        node.bytes = bytes;
+        CacheUnlink(slot);
+        CachePushFront(slot);
+        return;
     }
-    total = 0;
 
-    // icn cache
-    uint32_t used = 0;
+    uint32_t free = lru_free;
 
-    for (auto& icns : icn_cache)
+    if (free)
+        lru_free = lru_nodes[free].next;
+    else
     {
-        for (uint32_t jj = 0; jj < icns.count; ++jj)
-        {
-            if (icns.sprites)
-            {
-                Sprite& sprite1 = icns.sprites[jj];
+        free = lru_nodes.size();
+        lru_nodes.emplace_back();
+    }
 
-                if (!sprite1.isRefCopy())
-                {
-                    total += sprite1.GetMemoryUsage();
-                    sprite1.Reset();
-                }
-                else
-                    used += sprite1.GetMemoryUsage();
-            }
+    lru_node_t& node = lru_nodes[free];
+    node.type = type;
+    node.id = id;
+    node.index = index;
+    node.bytes = bytes;
+    CachePushFront(free);
+
+    slot = free;
+    cache_stats.bytes += bytes;
+    cache_stats.types[type] += bytes;
+    ++cache_stats.entries;
+}
 
-            if (icns.reflect)
-            {
-                Sprite& sprite2 = icns.reflect[jj];
+/* sprites filled besides the requested one: LoadExtICN batches and PutICN */
+void AGG::CacheRegisterICN(int icn)
+{
+    icn_cache_t& v = icn_cache[icn];
 
-                if (!sprite2.isRefCopy())
-                {
-                    total += sprite2.GetMemoryUsage();
-                    sprite2.Reset();
-                }
-                else
-                    used += sprite2.GetMemoryUsage();
-            }
+    if (v.lru.size() < 2 * v.count) v.lru.resize(2 * v.count, 0);
+
+    for (uint32_t ii = 0; ii < 2 * v.count; ++ii)
+    {
+        const Sprite* sprites = ii < v.count ? v.sprites : v.reflect;
+        const uint32_t index = ii < v.count ? ii : ii - v.count;
+
+        if (!v.lru[ii] && sprites && sprites[index].isValid())
+            CacheRegister(v.lru[ii], CACHE_ICN, icn, ii, sprites[index].GetMemoryUsage());
+    }
+}
+
+uint32_t& AGG::CacheSlot(const lru_node_t& node)
+{
+    switch (node.type)
+    {
+    case CACHE_TIL:
+        return til_cache[node.id].lru[node.index];
+    case CACHE_FNT:
+        return fnt_cache[node.id].lru;
+    default:
+        break;
+    }
+
+    return icn_cache[node.id].lru[node.index];
+}
+
+/* frees the surface if nobody holds a copy */
+bool AGG::CacheEvict(const lru_node_t& node)
+{
+    switch (node.type)
+    {
+    case CACHE_TIL:
+        {
+            Surface& surface = til_cache[node.id].sprites[node.index];
+            if (surface.isRefCopy()) return false;
+            surface.Reset();
+            return true;
         }
+
+    case CACHE_FNT:
+        {
+            fnt_cache_t& glyph = fnt_cache[node.id];
+            for (const Surface& surface : glyph.sfs)
+                if (surface.isRefCopy()) return false;
+            for (Surface& surface : glyph.sfs)
+                surface.Reset();
+            return true;
+        }
+
+    default:
+        break;
     }
 
-    return total;
+    // PutICN sprites can not be loaded again
+    if (ICN::LASTICN <= node.id) return false;
+
+    icn_cache_t& v = icn_cache[node.id];
+    Sprite& sprite = node.index < v.count ? v.sprites[node.index] : v.reflect[node.index - v.count];
+    if (sprite.isRefCopy()) return false;
+    sprite.Reset();
+    return true;
 }
 
+/* evicts the least recently used surfaces over the memory limit, surfaces in use and the newest one stay */
 bool AGG::CheckMemoryLimit()
 {
-    Settings& conf = Settings::Get();
+    const uint32_t limit = Settings::Get().MemoryLimit();
 
-    // memory limit trigger
-    if ( 0 < conf.MemoryLimit() && memlimit_usage)
+    if (0 == limit || !memlimit_usage || cache_stats.bytes <= limit)
+        return false;
+
+    for (uint32_t id = lru_nodes[0].prev; id != lru_nodes[0].next && cache_stats.bytes > limit;)
     {
-        uint32_t usage = System::GetMemoryUsage();
+        const uint32_t prev = lru_nodes[id].prev;
+        lru_node_t& node = lru_nodes[id];
 
-        if (0 < usage && conf.MemoryLimit() < usage)
+        if (CacheEvict(node))
         {
-            H2VERBOSE("settings: " << conf.MemoryLimit() << ", game usage: " << usage);
-            const uint32_t freemem = ClearFreeObjects();
-            H2VERBOSE("free " << freemem);
+            CacheSlot(node) = 0;
+            CacheUnlink(id);
+            cache_stats.bytes -= node.bytes;
+            cache_stats.types[node.type] -= node.bytes;
+            --cache_stats.entries;
+            ++cache_stats.evictions;
+            node.next = lru_free;
+            lru_free = id;
+        }
 
-            usage = System::GetMemoryUsage();
+        id = prev;
+    }
 
-            if (conf.MemoryLimit() < usage + 300 * 1024)
-            {
-                H2VERBOSE("settings: " << conf.MemoryLimit() << ", too small");
-                // increase + 300Kb
-                conf.SetMemoryLimit(usage + 300 * 1024);
-                H2VERBOSE("settings: " << "increase limit on 300kb, current value: " << conf.MemoryLimit());
-            }
+    return true;
+}
 
-            return true;
-        }
-    }
+string AGG::CacheInfo()
+{
+    ostringstream os;
 
-    return false;
+    os << "sprite cache: entries: " << cache_stats.entries << ", bytes: " << cache_stats.bytes <<
+        ", limit: " << Settings::Get().MemoryLimit() << ", hits: " << cache_stats.hits <<
+        ", misses: " << cache_stats.misses << ", evictions: " << cache_stats.evictions <<
+        ", prefetched: " << cache_stats.prefetched << endl;
+
+    const CacheBytes usage = GetCacheBytes();
+    os << "cache bytes: icn: " << usage.icn << ", til: " << usage.til << ", fnt: " << usage.fnt <<
+        ", wav: " << usage.wav << ", mid: " << usage.mid << ", mixer: " << usage.mixer << ", total: " << usage.Total();
+
+    return os.str();
+}
+
+uint32_t AGG::CacheBytes::Total() const
+{
+    return icn + til + fnt + wav + mid + mixer;
+}
+
+AGG::CacheBytes AGG::GetCacheBytes()
+{
+    CacheBytes res;
+
+    res.icn = cache_stats.types[CACHE_ICN];
+    res.til = cache_stats.types[CACHE_TIL];
+    res.fnt = cache_stats.types[CACHE_FNT];
+    res.wav = cache_stats.wav;
+    res.mid = cache_stats.mid;
+    res.mixer = Mixer::CacheBytes();
+
+    return res;
 }
 
 /* read data directory */
@@ -276,26 +441,112 @@ bool AGG::ReadDataDir()
 
     if (heroes2x_agg.isGood()) conf.SetPriceLoyaltyVersion();
 
+    if (heroes2_agg.isGood() && atlas.Open(AtlasName(), heroes2_agg.Size(), heroes2x_agg.Size()))
+        H2VERBOSE("use atlas: " << AtlasName());
+
     return heroes2_agg.isGood();
 }
 
-vector<u8> AGG::ReadChunk(const string& key)
+/* next to heroes2.agg */
+string AGG::AtlasName()
+{
+    const string& name = heroes2_agg.Name();
+
+    return name.substr(0, name.size() - 4) + ".atl";
+}
+
+/* frames of the original ICN in the archives' own order, ICN generated by LoadExtICN stay empty */
+string AGG::WriteAtlas()
+{
+    if (!heroes2_agg.isGood() && !ReadDataDir())
+        return string();
+
+    if (icn_cache.size() < ICN::LASTICN)
+        icn_cache.resize(ICN::LASTICN);
+
+    vector<u8> out(Atlas::HEADER_SIZE + ICN::LASTICN * Atlas::ICN_ENTRY_SIZE);
+
+    auto put16 = [&out](uint32_t pos, uint32_t val)
+    {
+        out[pos] = val;
+        out[pos + 1] = val >> 8;
+    };
+
+    auto put32 = [&](uint32_t pos, uint32_t val)
+    {
+        put16(pos, val);
+        put16(pos + 2, val >> 16);
+    };
+
+    put32(0, Atlas::MAGIC);
+    put32(4, Atlas::VERSION);
+    put32(8, heroes2_agg.Size());
+    put32(12, heroes2x_agg.Size());
+    put32(16, ICN::LASTICN);
+
+    vector<u8> pixels;
+    vector<u8> mask;
+
+    for (int icn = ICN::UNKNOWN + 1; icn < ICN::LASTICN; ++icn)
+    {
+        if (ExtICNCount(icn))
+            continue;
+
+        const uint32_t count = GetICNFrames(icn, 0).frames.size();
+        if (0 == count)
+            continue;
+
+        const uint32_t entry = Atlas::HEADER_SIZE + icn * Atlas::ICN_ENTRY_SIZE;
+        const uint32_t table = out.size();
+
+        put32(entry, table);
+        put32(entry + 4, count);
+        out.resize(table + count * Atlas::FRAME_SIZE);
+
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            // the loyalty ultimate staff comes from its own table
+            const icn_cache_t& source = GetICNFrames(icn, index);
+            const icn_frame_t frame = index < source.frames.size() ? source.frames[index] : icn_frame_t();
+            const uint32_t plane = frame.width * frame.height;
+            const uint32_t record = table + index * Atlas::FRAME_SIZE;
+
+            DecodeICNFrame(source.body, frame, pixels, mask);
+
+            put16(record, frame.offsetX);
+            put16(record + 2, frame.offsetY);
+            put16(record + 4, frame.width);
+            put16(record + 6, frame.height);
+            put32(record + 8, frame.type);
+            put32(record + 12, out.size());
+
+            out.insert(out.end(), pixels.begin(), pixels.begin() + plane);
+            out.insert(out.end(), mask.begin(), mask.begin() + plane);
+        }
+    }
+
+    const string file = AtlasName();
+    FileUtils::writeFileBytes(file, out);
+
+    return file;
+}
+
+AGG::Chunk AGG::ReadChunk(const string& key)
 {
     if (heroes2x_agg.isGood())
     {
-        const vector<u8>& buf = heroes2x_agg.Read(key);
+        const Chunk buf = heroes2x_agg.Read(key);
         if (!buf.empty()) return buf;
     }
 
     return heroes2_agg.Read(key);
 }
 
-/* load manual ICN object */
-bool AGG::LoadExtICN(int icn, uint32_t index, bool reflect)
+/* count of sprites generated by LoadExtICN, 0 for the original ICN */
+uint32_t AGG::ExtICNCount(int icn)
 {
     // for animation sprite need update count for ICN::AnimationFrame
     uint32_t count = 0;
-    const Settings& conf = Settings::Get();
 
     switch (icn)
     {
@@ -339,6 +590,15 @@ bool AGG::LoadExtICN(int icn, uint32_t index, bool reflect)
         break;
     }
 
+    return count;
+}
+
+/* load manual ICN object */
+bool AGG::LoadExtICN(int icn, uint32_t index, bool reflect)
+{
+    const uint32_t count = ExtICNCount(icn);
+    const Settings& conf = Settings::Get();
+
     // not modify sprite
     if (0 == count) return false;
 
@@ -573,49 +833,105 @@ bool AGG::LoadExtICN(int icn, uint32_t index, bool reflect)
 
 bool AGG::LoadAltICN(int icn, uint32_t index, bool reflect)
 {
-    return false;
+    const uint32_t count = atlas.ICNCount(icn);
+
+    if (0 == count)
+        return false;
+
+    icn_cache_t& v = icn_cache[icn];
+
+    if (nullptr == v.sprites)
+    {
+        v.count = count;
+        v.sprites = new Sprite[v.count];
+        v.reflect = new Sprite[v.count];
+    }
+
+    icn_frame_t frame;
+    const u8* pixels = nullptr;
+    const u8* mask = nullptr;
+
+    if (index >= v.count || !atlas.ICNFrame(icn, index, frame, pixels, mask))
+        return false;
+
+    const ICNSprite res = RenderICNFrame(icn, pixels, mask, frame);
+
+    if (!res.isValid())
+        return false;
+
+    Sprite& sp = reflect ? v.reflect[index] : v.sprites[index];
+    sp = *res.CreateSprite(reflect, !ICN::SkipLocalAlpha(icn));
+
+    return true;
 }
 
 void AGG::SaveICN(int icn)
 {
 }
 
-vector<u8> AGG::ReadICNChunk(int icn, uint32_t index)
+/* parses the frame header table: count, block size, 13 bytes per frame */
+void AGG::ReadICNFrames(const Chunk& body, vector<icn_frame_t>& frames)
 {
-    // hard fix artifact "ultimate stuff" sprite for loyalty version
-    if (ICN::ARTIFACT == icn &&
-        Artifact(Artifact::ULTIMATE_STAFF).IndexSprite64() == index && heroes2x_agg.isGood())
+    frames.clear();
+    if (body.size < 6)
+        return;
+
+    ByteVectorReader st(body.data, body.size);
+
+    const uint32_t count = st.getLE16();
+    const uint32_t blockSize = st.getLE32();
+
+    if (6 + count * 13 > body.size)
+        return;
+
+    frames.resize(count);
+
+    for (auto& frame : frames)
     {
-        return heroes2x_agg.Read(ICN::GetString(icn));
+        frame.offsetX = st.getLE16();
+        frame.offsetY = st.getLE16();
+        frame.width = st.getLE16();
+        frame.height = st.getLE16();
+        frame.type = st.Get8();
+        frame.offset = 6 + st.getLE32();
     }
 
-    return ReadChunk(ICN::GetString(icn));
+    for (uint32_t ii = 0; ii < count; ++ii)
+    {
+        icn_frame_t& frame = frames[ii];
+        const uint32_t end = std::min(ii + 1 < count ? frames[ii + 1].offset : 6 + blockSize, body.size);
+
+        frame.size = frame.offset < end ? end - frame.offset : 0;
+    }
 }
 
-struct ICNHeader
+const AGG::icn_cache_t& AGG::GetICNFrames(int icn, uint32_t index)
 {
-    ICNHeader() : offsetX(0), offsetY(0), width(0), height(0), type(0), offsetData(0)
+    // hard fix artifact "ultimate stuff" sprite for loyalty version
+    if (ICN::ARTIFACT == icn &&
+        Artifact(Artifact::ULTIMATE_STAFF).IndexSprite64() == index && heroes2x_agg.isGood())
     {
+        static icn_cache_t loyalty;
+
+        if (!loyalty.parsed)
+        {
+            loyalty.body = heroes2x_agg.Read(ICN::GetString(icn));
+            ReadICNFrames(loyalty.body, loyalty.frames);
+            loyalty.parsed = true;
+        }
+        return loyalty;
     }
 
-    u16 offsetX;
-    u16 offsetY;
-    u16 width;
-    u16 height;
-    u8 type;
-    uint32_t offsetData;
-};
+    icn_cache_t& v = icn_cache[icn];
 
-ByteVectorReader& operator>>(ByteVectorReader& st, ICNHeader& icn)
-{
-    icn.offsetX = st.getLE16();
-    icn.offsetY = st.getLE16();
-    icn.width = st.getLE16();
-    icn.height = st.getLE16();
-    icn.type = st.Get8();
-    icn.offsetData = st.getLE32();
+    if (!v.parsed)
+    {
+        v.body = ReadChunk(ICN::GetString(icn));
+        ReadICNFrames(v.body, v.frames);
+        v.parsed = true;
+    }
 
-    return st;
+    return v;
 }
 
 void AGG::RenderICNSprite(int icn, uint32_t index, const Rect& srt, const Point& dpt, Surface& dst)
@@ -647,57 +963,77 @@ std::string joinValues(const std::vector<u8>& body, int maxSize)
 
 AGG::ICNSprite AGG::RenderICNSprite(int icn, uint32_t index)
 {
-    ICNSprite res;
-    const vector<u8> body = ReadICNChunk(icn, index);
-    if (body.empty())
+    if (icn >= static_cast<int>(icn_cache.size()))
     {
-        return res;
+        return ICNSprite();
     }
 
-    ByteVectorReader st(body);
-
-    const auto count = st.getLE16();
-    if (index >= count)
+    const icn_cache_t& v = GetICNFrames(icn, index);
+    if (index >= v.frames.size())
     {
-        return res;
+        return ICNSprite();
     }
-    const auto blockSize = st.getLE32();
 
-    if (index) st.skip(index * 13);
+    return RenderICNFrame(icn, v.body, v.frames[index]);
+}
+
+AGG::ICNFrameWriter::ICNFrameWriter(ICNSprite& sprite, const icn_frame_t& header1) : res(sprite),
+                                                                                      width(header1.width),
+                                                                                      height(header1.height)
+{
+    res.offset = Point(header1.offsetX, header1.offsetY);
+    res.first.Set(width, height, false);
+    // skip alpha
+    shadow = res.first.depth() != 8;
+    res.first.Lock();
+}
 
-    ICNHeader header1;
-    st >> header1;
+void AGG::ICNFrameWriter::operator()(uint32_t x, uint32_t y, u8 index, u8 type)
+{
+    if (x >= width || y >= height)
+        return;
 
-    uint32_t sizeData = 0;
-    if (index + 1 != count)
+    if (Atlas::MASK_COLOR == type)
     {
-        ICNHeader header2;
-        st >> header2;
-        sizeData = header2.offsetData - header1.offsetData;
+        DrawPointFast(res.first, x, y, index);
     }
-    else
-        sizeData = blockSize - header1.offsetData;
-
-    // start render
-    const Size sz = Size(header1.width, header1.height);
-
-    const u8* buf = &body[6 + header1.offsetData];
-    const u8* max = buf + sizeData;
-
-    res.offset = Point(header1.offsetX, header1.offsetY);
-    Surface& sf1 = res.first;
-    Surface& sf2 = res.second;
+    else if (Atlas::MASK_SHADOW == type && shadow)
+    {
+        if (!res.second.isValid())
+        {
+            res.second.Set(width, height, true);
+            res.second.Lock();
+        }
+        res.second.SetPixel4(x, y, RGBA::packRgba(0, 0, 0, 0x40));
+    }
+}
 
-    sf1.Set(sz.w, sz.h, false);
+void AGG::ICNFrameWriter::Finish(int icn)
+{
+    // fix air elem sprite
+    if (icn == ICN::AELEM &&
+        res.first.w() > 3 && res.first.h() > 3)
+    {
+        res.first.RenderContour(RGBA(0, 0x84, 0xe0)).Blit(-1, -1, res.first);
+    }
+    res.first.Unlock();
+    if (res.second.isValid())
+    {
+        res.second.Unlock();
+    }
+}
 
-    const uint32_t shadowCol = RGBA::packRgba(0, 0, 0, 0x40);
+/* RLE of one frame, every pixel goes to put(x, y, palette index, mask type) */
+template <typename Put>
+void AGG::DecodeICNRLE(const Chunk& body, const icn_frame_t& header1, Put& put)
+{
+    const u8* buf = body.data + header1.offset;
+    const u8* max = buf + header1.size;
 
     uint32_t c = 0;
     Point pt(0, 0);
-    sf1.Lock();
     while (true)
     {
-        auto cur = *buf;
         // 0x00 - end line
         if (0 == *buf)
         {
@@ -713,7 +1049,7 @@ AGG::ICNSprite AGG::RenderICNSprite(int icn, uint32_t index)
                 ++buf;
                 while (c-- && buf < max)
                 {
-                    DrawPointFast(sf1, pt.x, pt.y, *buf);
+                    put(pt.x, pt.y, *buf, Atlas::MASK_COLOR);
                     ++pt.x;
                     ++buf;
                 }
@@ -738,23 +1074,10 @@ AGG::ICNSprite AGG::RenderICNSprite(int icn, uint32_t index)
                             ++buf;
                             c = *buf % 4 ? *buf % 4 : *++buf;
 
-                            if (sf1.depth() == 8) // skip alpha
+                            while (c--)
                             {
-                                pt.x += c;
-                                c = 0;
-                            }
-                            else
-                            {
-                                if (!sf2.isValid())
-                                {
-                                    sf2.Set(sz.w, sz.h, true);
-                                    sf2.Lock();
-                                }
-                                while (c--)
-                                {
-                                    sf2.SetPixel4(pt.x, pt.y, shadowCol);
-                                    ++pt.x;
-                                }
+                                put(pt.x, pt.y, 0, Atlas::MASK_SHADOW);
+                                ++pt.x;
                             }
                             ++buf;
                         }
@@ -767,7 +1090,7 @@ AGG::ICNSprite AGG::RenderICNSprite(int icn, uint32_t index)
                                 ++buf;
                                 while (c--)
                                 {
-                                    DrawPointFast(sf1, pt.x, pt.y, *buf);
+                                    put(pt.x, pt.y, *buf, Atlas::MASK_COLOR);
                                     ++pt.x;
                                 }
                                 ++buf;
@@ -778,7 +1101,7 @@ AGG::ICNSprite AGG::RenderICNSprite(int icn, uint32_t index)
                                 ++buf;
                                 while (c--)
                                 {
-                                    DrawPointFast(sf1, pt.x, pt.y, *buf);
+                                    put(pt.x, pt.y, *buf, Atlas::MASK_COLOR);
                                     ++pt.x;
                                 }
                                 ++buf;
@@ -788,18 +1111,64 @@ AGG::ICNSprite AGG::RenderICNSprite(int icn, uint32_t index)
             break;
         }
     }
+}
 
-    // fix air elem sprite
-    if (icn == ICN::AELEM &&
-        res.first.w() > 3 && res.first.h() > 3)
+/* decodes one frame straight into the surfaces, touches no cache state */
+AGG::ICNSprite AGG::RenderICNFrame(int icn, const Chunk& body, const icn_frame_t& header1)
+{
+    ICNSprite res;
+
+    if (0 == header1.size)
     {
-        res.first.RenderContour(RGBA(0, 0x84, 0xe0)).Blit(-1, -1, res.first);
+        return res;
     }
-    sf1.Unlock();
-    if (sf2.isValid())
+
+    ICNFrameWriter put(res, header1);
+    DecodeICNRLE(body, header1, put);
+    put.Finish(icn);
+
+    return res;
+}
+
+/* RLE to palette index and mask planes for the atlas writer and the prefetch workers */
+void AGG::DecodeICNFrame(const Chunk& body, const icn_frame_t& header1, vector<u8>& pixels, vector<u8>& mask)
+{
+    const uint32_t width = header1.width;
+    const uint32_t height = header1.height;
+
+    pixels.assign(width * height + 1, 0);
+    mask.assign(width * height + 1, Atlas::MASK_NONE);
+
+    if (0 == header1.size)
     {
-        sf2.Unlock();
+        return;
     }
+
+    auto put = [&](uint32_t x, uint32_t y, u8 index, u8 type)
+    {
+        if (x < width && y < height)
+        {
+            pixels[y * width + x] = index;
+            mask[y * width + x] = type;
+        }
+    };
+
+    DecodeICNRLE(body, header1, put);
+}
+
+/* palette lookup of the decoded planes, no RLE */
+AGG::ICNSprite AGG::RenderICNFrame(int icn, const u8* pixels, const u8* mask, const icn_frame_t& header1)
+{
+    ICNSprite res;
+    ICNFrameWriter put(res, header1);
+
+    for (uint32_t y = 0; y < header1.height; ++y)
+        for (uint32_t x = 0; x < header1.width; ++x, ++pixels, ++mask)
+            if (Atlas::MASK_NONE != *mask)
+                put(x, y, *pixels, *mask);
+
+    put.Finish(icn);
+
     return res;
 }
 
@@ -820,12 +1189,11 @@ bool AGG::LoadOrgICN(int icn, uint32_t index, bool reflect)
 
     if (nullptr == v.sprites)
     {
-        const vector<u8>& body = ReadChunk(ICN::GetString(icn));
+        const icn_cache_t& frames = GetICNFrames(icn, index);
 
-        if (body.empty())
+        if (frames.body.empty())
             return false;
-        ByteVectorReader bvr(body);
-        v.count = bvr.getLE16();
+        v.count = frames.frames.size();
         v.sprites = new Sprite[v.count];
         v.reflect = new Sprite[v.count];
         if (v.count == 0)
@@ -850,10 +1218,9 @@ void AGG::LoadICN(int icn, uint32_t index, bool reflect)
         && (reflect || (v.sprites &&
             (index >= v.count || v.sprites[index].isValid()))))
         return;
-    const Settings& conf = Settings::Get();
 
-    // load from images dir
-    if (conf.UseAltResource() && LoadAltICN(icn, index, reflect))
+    // load from the pre-decoded atlas
+    if (LoadAltICN(icn, index, reflect))
         return;
     // load modify sprite
     if (LoadExtICN(icn, index, reflect))
@@ -868,6 +1235,9 @@ Sprite AGG::GetICN(int icn, uint32_t index, bool reflect)
 {
     Sprite result;
 
+    if (prefetch.ready)
+        PrefetchCollect();
+
     if (icn >= static_cast<int>(icn_cache.size()))
     {
         return result;
@@ -880,13 +1250,27 @@ Sprite AGG::GetICN(int icn, uint32_t index, bool reflect)
         index = 0;
     }
 
-    // need load?
-    if (0 == v.count ||
-        ((reflect && (!v.reflect || !v.reflect[index].isValid())) || (!v.sprites || !v.sprites[index].isValid())))
+    const Sprite* sprites = reflect ? v.reflect : v.sprites;
+
+    // need load? only the requested side counts
+    if (0 == v.count || !sprites || !sprites[index].isValid())
     {
-        CheckMemoryLimit();
+        PROFILE_SCOPE("AGG::GetICN miss");
         LoadICN(icn, index, reflect);
+
+        if (index < v.count)
+        {
+            if (v.lru.size() < 2 * v.count) v.lru.resize(2 * v.count, 0);
+
+            const Sprite& sprite = reflect ? v.reflect[index] : v.sprites[index];
+            CacheInsert(v.lru[index + (reflect ? v.count : 0)], CACHE_ICN, icn, index + (reflect ? v.count : 0),
+                        sprite.GetMemoryUsage());
+            if (ExtICNCount(icn)) CacheRegisterICN(icn);
+            CheckMemoryLimit();
+        }
     }
+    else
+        CacheTouch(v.lru.empty() ? 0 : v.lru[index + (reflect ? v.count : 0)]);
 
     result = reflect ? v.reflect[index] : v.sprites[index];
 
@@ -894,11 +1278,163 @@ Sprite AGG::GetICN(int icn, uint32_t index, bool reflect)
     return result;
 }
 
+int AGG::PrefetchWorker(void*)
+{
+    while (prefetch.jobs.Wait() && !prefetch.stop)
+    {
+        prefetch.lock.Lock();
+        if (prefetch.queue.empty())
+        {
+            prefetch.lock.Unlock();
+            continue;
+        }
+        prefetch_job_t job = prefetch.queue.front();
+        prefetch.queue.pop_front();
+        prefetch.lock.Unlock();
+
+        // plain buffers only: SDL surfaces are not safe to create or blit beside the main thread
+        DecodeICNFrame(job.body, job.frame, job.pixels, job.mask);
+
+        prefetch.lock.Lock();
+        prefetch.done.push_back(job);
+        ++prefetch.ready;
+        prefetch.lock.Unlock();
+    }
+
+    return 0;
+}
+
+bool AGG::PrefetchStart()
+{
+    if (prefetch.workers.empty())
+    {
+        prefetch.lock.Create();
+        prefetch.jobs.Create();
+        prefetch.stop = false;
+
+        // leave a core to the main thread
+        const uint32_t cores = thread::hardware_concurrency();
+        prefetch.workers.resize(cores > 2 ? min(2u, cores - 1) : 1);
+
+        for (auto& worker : prefetch.workers)
+            worker.Create(PrefetchWorker);
+    }
+
+    return prefetch.workers.front().IsRun();
+}
+
+void AGG::PrefetchStop()
+{
+    if (prefetch.workers.empty())
+        return;
+
+    prefetch.stop = true;
+    for (uint32_t ii = 0; ii < prefetch.workers.size(); ++ii)
+        prefetch.jobs.Post();
+    for (auto& worker : prefetch.workers)
+        worker.Wait();
+
+    prefetch.workers.clear();
+    prefetch.queue.clear();
+    prefetch.done.clear();
+    prefetch.pending.clear();
+    prefetch.ready = 0;
+}
+
+/* makes the sprites of the decoded frames and moves them into the cache, main thread only */
+void AGG::PrefetchCollect()
+{
+    vector<prefetch_job_t> done;
+
+    prefetch.lock.Lock();
+    done.swap(prefetch.done);
+    prefetch.ready = 0;
+    prefetch.lock.Unlock();
+
+    for (const prefetch_job_t& job : done)
+    {
+        prefetch.pending.erase(job.icn << 16 | job.index);
+
+        icn_cache_t& v = icn_cache[job.icn];
+
+        // skip frames loaded by GetICN in the meantime
+        if (0 == job.frame.size || !v.sprites || job.index >= v.count || v.sprites[job.index].isValid())
+            continue;
+
+        const ICNSprite res = RenderICNFrame(job.icn, &job.pixels[0], &job.mask[0], job.frame);
+        if (!res.isValid())
+            continue;
+
+        v.sprites[job.index] = *res.CreateSprite(false, !ICN::SkipLocalAlpha(job.icn));
+
+        if (v.lru.size() < 2 * v.count) v.lru.resize(2 * v.count, 0);
+        // decoded ahead of a request: accounted, but not a miss
+        CacheRegister(v.lru[job.index], CACHE_ICN, job.icn, job.index, v.sprites[job.index].GetMemoryUsage());
+        ++cache_stats.prefetched;
+    }
+
+    CheckMemoryLimit();
+}
+
+void AGG::Prefetch(int icn, uint32_t first, uint32_t count)
+{
+    // generated sprites are loaded on demand, atlas frames need no decoding
+    if (icn <= ICN::UNKNOWN || icn >= ICN::LASTICN || ExtICNCount(icn) || atlas.ICNCount(icn))
+        return;
+
+    const icn_cache_t& source = GetICNFrames(icn, first);
+    if (source.body.empty() || source.frames.empty() || !PrefetchStart())
+        return;
+
+    icn_cache_t& v = icn_cache[icn];
+
+    if (nullptr == v.sprites)
+    {
+        v.count = source.frames.size();
+        v.sprites = new Sprite[v.count];
+        v.reflect = new Sprite[v.count];
+    }
+
+    const uint32_t last = count ? min(first + count, v.count) : v.count;
+    vector<prefetch_job_t> jobs;
+
+    for (uint32_t index = first; index < last; ++index)
+    {
+        if (v.sprites[index].isValid() || !prefetch.pending.insert(icn << 16 | index).second)
+            continue;
+
+        const icn_cache_t& frames = GetICNFrames(icn, index);
+
+        prefetch_job_t job;
+        job.icn = icn;
+        job.index = index;
+        job.body = frames.body;
+        job.frame = index < frames.frames.size() ? frames.frames[index] : icn_frame_t();
+        jobs.push_back(job);
+    }
+
+    if (jobs.empty())
+        return;
+
+    prefetch.lock.Lock();
+    prefetch.queue.insert(prefetch.queue.end(), jobs.begin(), jobs.end());
+    prefetch.lock.Unlock();
+
+    for (uint32_t ii = 0; ii < jobs.size(); ++ii)
+        prefetch.jobs.Post();
+}
+
 /* return count of sprites from specific ICN */
 uint32_t AGG::GetICNCount(int icn)
 {
-    if (icn_cache[icn].count == 0) GetICN(icn, 0);
-    return icn_cache[icn].count;
+    icn_cache_t& v = icn_cache[icn];
+
+    // original ICN: the header table knows the count, no decoding
+    if (0 == v.count && !GetICNFrames(icn, 0).frames.empty())
+        return v.frames.size();
+
+    if (0 == v.count) GetICN(icn, 0);
+    return v.count;
 }
 
 
@@ -917,6 +1453,7 @@ int AGG::PutICN(const Sprite& sprite, bool init_reflect)
     }
 
     icn_cache.push_back(v);
+    CacheRegisterICN(icn_cache.size() - 1);
     return icn_cache.size() - 1;
 }
 
@@ -931,11 +1468,11 @@ void AGG::SaveTIL(int til)
 
 bool AGG::LoadOrgTIL(int til, uint32_t max)
 {
-    vector<u8> body = ReadChunk(TIL::GetString(til));
+    const Chunk body = ReadChunk(TIL::GetString(til));
 
     if (body.empty())
         return false;
-    ByteVectorReader st(body);
+    ByteVectorReader st(body.data, body.size);
 
     const uint32_t count = st.getLE16();
     const uint32_t width = st.getLE16();
@@ -947,10 +1484,10 @@ bool AGG::LoadOrgTIL(int til, uint32_t max)
     til_cache_t& v = til_cache[til];
 
     // check size
-    if (body.size() == body_size && count <= max)
+    if (body.size == body_size && count <= max)
     {
         for (uint32_t ii = 0; ii < count; ++ii)
-            v.sprites[ii] = Surface(&body[6 + ii * tile_size], width, height, 1, false);
+            v.sprites[ii] = Surface(body.data + 6 + ii * tile_size, width, height, 1, false);
 
         return true;
     }
@@ -984,10 +1521,11 @@ void AGG::LoadTIL(int til)
 
     v.count = max * 4; // rezerve for rotate sprites
     v.sprites = new Surface[v.count];
+    v.lru.assign(v.count, 0);
 
     const Settings& conf = Settings::Get();
 
-    // load from images dir
+    // load from images dir: tiles are raw palette indexes already, the atlas keeps no copy
     if (!conf.UseAltResource() || !LoadAltTIL(til, max))
     {
         if (!LoadOrgTIL(til, max))
@@ -1037,8 +1575,14 @@ Surface AGG::GetTIL(int til, uint32_t index, uint32_t shape)
             const Surface& src = v.sprites[index];
 
             if (src.isValid())
+            {
                 surface = src.RenderReflect(shape);
+                CacheInsert(v.lru[index2], CACHE_TIL, til, index2, surface.GetMemoryUsage());
+                CheckMemoryLimit();
+            }
         }
+        else
+            CacheTouch(v.lru[index2]);
 
 
         result = surface;
@@ -1074,14 +1618,14 @@ void AGG::LoadWAV(int m82, std::vector<u8>& v)
         if (!v.empty()) return;
     }
 
-    const vector<u8>& body = ReadChunk(M82::GetString(m82));
+    const Chunk body = ReadChunk(M82::GetString(m82));
 
     if (body.empty())
         return;
     // create WAV format
     ByteVectorWriter wavHeader(44);
     wavHeader.putLE32(0x46464952); // RIFF
-    wavHeader.putLE32(body.size() + 0x24); // size
+    wavHeader.putLE32(body.size + 0x24); // size
     wavHeader.putLE32(0x45564157); // WAVE
     wavHeader.putLE32(0x20746D66); // FMT
     wavHeader.putLE32(0x10); // size_t
@@ -1092,28 +1636,32 @@ void AGG::LoadWAV(int m82, std::vector<u8>& v)
     wavHeader.putLE16(0x01); // align
     wavHeader.putLE16(0x08); // bitsper
     wavHeader.putLE32(0x61746164); // DATA
-    wavHeader.putLE32(body.size()); // size
+    wavHeader.putLE32(body.size); // size
 
-    v.reserve(body.size() + 44);
+    v.reserve(body.size + 44);
     auto vecData = wavHeader.data();
     v.assign(vecData.begin(), vecData.end());
-    v.insert(v.begin() + 44, body.begin(), body.end());
+    v.insert(v.end(), body.begin(), body.end());
 }
 
 /* load XMI object */
 void AGG::LoadMID(int xmi, vector<u8>& v)
 {
-    const vector<u8> body = ReadChunk(XMI::GetString(xmi));
+    const Chunk body = ReadChunk(XMI::GetString(xmi));
 
     if (!body.empty())
-        v = Music::Xmi2Mid(body);
+        v = Music::Xmi2Mid(vector<u8>(body.begin(), body.end()));
 }
 
 /* return CVT */
 const vector<u8>& AGG::GetWAV(int m82)
 {
     vector<u8>& v = wav_cache[m82];
-    if (Mixer::isValid() && v.empty()) LoadWAV(m82, v);
+    if (Mixer::isValid() && v.empty())
+    {
+        LoadWAV(m82, v);
+        cache_stats.wav += v.size();
+    }
     return v;
 }
 
@@ -1121,7 +1669,11 @@ const vector<u8>& AGG::GetWAV(int m82)
 const vector<u8>& AGG::GetMID(int xmi)
 {
     vector<u8>& v = mid_cache[xmi];
-    if (Mixer::isValid() && v.empty()) LoadMID(xmi, v);
+    if (Mixer::isValid() && v.empty())
+    {
+        LoadMID(xmi, v);
+        cache_stats.mid += v.size();
+    }
     return v;
 }
 
@@ -1167,7 +1719,7 @@ void AGG::LoadLOOPXXSounds(const vector<int>& vols)
             if (0 != vol)
             {
                 const vector<u8>& v = GetWAV(m82);
-                int ch = Mixer::Play(&v[0], v.size(), -1, true);
+                int ch = Mixer::Play(m82, v.data(), v.size(), -1, true);
 
                 if (0 <= ch)
                 {
@@ -1198,7 +1750,7 @@ void AGG::PlaySound(int m82)
 
     if (!conf.Sound()) return;
     const vector<u8>& v = GetWAV(m82);
-    const int ch = Mixer::Play(&v[0], v.size(), -1, false);
+    const int ch = Mixer::Play(m82, v.data(), v.size(), -1, false);
     Mixer::Pause(ch);
     Mixer::Volume(ch, Mixer::MaxVolume() * conf.SoundVolume() / 10);
     Mixer::Resume(ch);
@@ -1319,9 +1871,22 @@ Surface AGG::GetUnicodeLetter(uint32_t ch, uint32_t ft)
     if (!ttf_valid)
         return GetLetter(ch, ft);
 
-    if (!fnt_cache[ch].sfs[0].isValid()) LoadTTFChar(ch);
+    fnt_cache_t& glyph = fnt_cache[ch];
+
+    if (!glyph.sfs[0].isValid())
+    {
+        LoadTTFChar(ch);
+
+        uint32_t bytes = 0;
+        for (const Surface& surface : glyph.sfs)
+            bytes += surface.GetMemoryUsage();
+        CacheInsert(glyph.lru, CACHE_FNT, ch, 0, bytes);
+        CheckMemoryLimit();
+    }
+    else
+        CacheTouch(glyph.lru);
 
-    const auto& surfaces = fnt_cache[ch].sfs;
+    const auto& surfaces = glyph.sfs;
     switch (ft)
     {
     case Font::YELLOW_SMALL:
@@ -1412,6 +1977,10 @@ bool AGG::Init()
 
 void AGG::Quit()
 {
+    // workers decode from the mapped archives
+    PrefetchStop();
+    atlas.Close();
+
     for (auto& icns : icn_cache)
     {
         delete[] icns.sprites;
@@ -1427,6 +1996,9 @@ void AGG::Quit()
     }
 
     til_cache.clear();
+    lru_nodes.assign(1, lru_node_t());
+    lru_free = 0;
+    cache_stats = cache_stats_t();
     wav_cache.clear();
     mid_cache.clear();
     loop_sounds.clear();
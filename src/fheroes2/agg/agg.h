@@ -24,6 +24,7 @@
 
 #include <vector>
 #include <utility>
+#include <string>
 
 #include "gamedefs.h"
 #include "sprite.h"
@@ -93,4 +94,28 @@ namespace AGG
     ICNSprite RenderICNSprite(int, uint32_t);
 
     void RenderICNSprite(int icn, uint32_t index, const Rect& srt, const Point& dpt, Surface& dst);
+
+    // hint: decode frames [first, first + count) in the background, count 0 for all
+    void Prefetch(int icn, uint32_t first = 0, uint32_t count = 0);
+
+    // decodes every original ICN frame into the atlas next to heroes2.agg, returns its name or empty
+    std::string WriteAtlas();
+
+    // sprite cache counters
+    std::string CacheInfo();
+
+    // bytes held by the caches, counted at insert and eviction
+    struct CacheBytes
+    {
+        uint32_t Total() const;
+
+        uint32_t icn = 0; // decoded sprites
+        uint32_t til = 0; // decoded ground tiles
+        uint32_t fnt = 0; // rendered glyphs
+        uint32_t wav = 0; // converted sounds
+        uint32_t mid = 0; // converted music
+        uint32_t mixer = 0; // sounds decoded by the mixer
+    };
+
+    CacheBytes GetCacheBytes();
 }
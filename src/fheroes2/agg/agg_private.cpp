@@ -5,7 +5,10 @@
 #include "agg_private.h"
 
 #include "BinaryFileReader.h"
+#include "ByteVectorReader.h"
+#include "system.h"
 #include <sstream>
+#include <iostream>
 
 namespace
 {
@@ -22,30 +25,31 @@ bool AGG::File::Open(const string& fname)
     filename = fname;
     if (!FileUtils::Exists(fname))
         return false;
-    fileContent = FileUtils::readFileBytes(filename);
-    stream = std::make_unique<ByteVectorReader>(fileContent);
+    if (!archive.open(filename))
+        return false;
+    ByteVectorReader stream(archive.data(), archive.size());
 
-    const uint32_t size = stream->size();
+    const uint32_t size = stream.size();
 
-    count_items = stream->getLE16();
+    count_items = stream.getLE16();
 
-    stream->seek(size - FATSIZENAME * count_items);
+    stream.seek(size - FATSIZENAME * count_items);
     std::vector<std::string> vectorNames;
     vectorNames.reserve(count_items);
     for (uint32_t ii = 0; ii < count_items; ++ii)
     {
-        vectorNames.push_back(stream->toString(FATSIZENAME));
+        vectorNames.push_back(stream.toString(FATSIZENAME));
     }
-    stream->seek(2);
+    stream.seek(2);
     for (uint32_t ii = 0; ii < count_items; ++ii)
     {
         const string& itemName = vectorNames[ii];
         FAT f;
-        const auto crc = stream->getLE32();
+        const auto crc = stream.getLE32();
         f.crc = crc;
-        const auto offset = stream->getLE32();
+        const auto offset = stream.getLE32();
         f.offset = offset;
-        const auto sizeChunk = stream->getLE32();
+        const auto sizeChunk = stream.getLE32();
         f.size = sizeChunk;
         fat[itemName] = f;
     }
@@ -57,7 +61,12 @@ AGG::File::~File() = default;
 
 bool AGG::File::isGood() const
 {
-    return stream && stream->size() && count_items;
+    return archive.size() && count_items;
+}
+
+uint32_t AGG::File::Size() const
+{
+    return archive.size();
 }
 
 /* get AGG file name */
@@ -81,29 +90,98 @@ string AGG::FAT::Info() const
     return os.str();
 }
 
-/* read element to body */
-vector<u8> AGG::File::Read(const string& str)
+/* element view, no copy */
+AGG::Chunk AGG::File::Read(const string& str) const
 {
     const auto it = fat.find(str);
 
     if (it == fat.end())
     {
-        vector<u8> emptyBuf;
-        return emptyBuf;
+        return Chunk();
     }
 
     const FAT& f = (*it).second;
-    key = str;
 
-    if (!f.size)
+    if (!f.size || f.offset > archive.size() || f.size > archive.size() - f.offset)
     {
-        vector<u8> emptyBuf;
-        return emptyBuf;
+        return Chunk();
     }
-    stream->seek(f.offset);
-    vector<u8> body = stream->getRaw(f.size);
 
+    return Chunk(archive.data() + f.offset, f.size);
+}
+
+/* the atlas is only valid for the archives it was built from */
+bool AGG::Atlas::Open(const string& fname, uint32_t aggSize, uint32_t aggxSize)
+{
+    Close();
+
+    if (!FileUtils::Exists(fname) || !file.open(fname))
+        return false;
+
+    ByteVectorReader stream(file.data(), file.size());
 
-    return body;
+    const uint32_t magic = stream.getLE32();
+    const uint32_t version = stream.getLE32();
+    const uint32_t size1 = stream.getLE32();
+    const uint32_t size2 = stream.getLE32();
+    icns = stream.getLE32();
+
+    if (MAGIC != magic || VERSION != version || aggSize != size1 || aggxSize != size2 ||
+        HEADER_SIZE + icns * ICN_ENTRY_SIZE > file.size())
+    {
+        H2VERBOSE("skip outdated atlas: " << fname);
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool AGG::Atlas::isGood() const
+{
+    return 0 != icns;
 }
 
+void AGG::Atlas::Close()
+{
+    file.close();
+    icns = 0;
+}
+
+uint32_t AGG::Atlas::ICNCount(int icn) const
+{
+    if (icn < 0 || static_cast<uint32_t>(icn) >= icns)
+        return 0;
+
+    ByteVectorReader stream(file.data(), file.size());
+    stream.seek(HEADER_SIZE + icn * ICN_ENTRY_SIZE + 4);
+
+    return stream.getLE32();
+}
+
+bool AGG::Atlas::ICNFrame(int icn, uint32_t index, icn_frame_t& frame, const u8*& pixels, const u8*& mask) const
+{
+    if (index >= ICNCount(icn))
+        return false;
+
+    ByteVectorReader stream(file.data(), file.size());
+    stream.seek(HEADER_SIZE + icn * ICN_ENTRY_SIZE);
+    stream.seek(stream.getLE32() + index * FRAME_SIZE);
+
+    frame.offsetX = stream.getLE16();
+    frame.offsetY = stream.getLE16();
+    frame.width = stream.getLE16();
+    frame.height = stream.getLE16();
+    frame.type = stream.getLE32();
+    frame.offset = stream.getLE32();
+
+    const uint32_t plane = frame.width * frame.height;
+    if (frame.offset > file.size() || 2 * plane > file.size() - frame.offset)
+        return false;
+
+    frame.size = 2 * plane;
+    pixels = file.data() + frame.offset;
+    mask = pixels + plane;
+
+    return true;
+}
@@ -5,11 +5,16 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
 #include <iostream>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include "settings.h"
 #include "sprite.h"
+#include "thread.h"
+#include "BinaryFileReader.h"
 
 namespace AGG
 {
@@ -28,6 +33,36 @@ namespace AGG
     };
 
 
+    /* element view into the mapped archive, valid while the archive is open */
+    struct Chunk
+    {
+        Chunk() : data(nullptr), size(0)
+        {
+        }
+
+        Chunk(const u8* d, uint32_t s) : data(d), size(s)
+        {
+        }
+
+        bool empty() const
+        {
+            return 0 == size;
+        }
+
+        const u8* begin() const
+        {
+            return data;
+        }
+
+        const u8* end() const
+        {
+            return data + size;
+        }
+
+        const u8* data;
+        uint32_t size;
+    };
+
     class File
     {
     public:
@@ -43,27 +78,86 @@ namespace AGG
 
         const FAT& Fat(const string& key);
 
-        vector<u8> Read(const string& str);
+        Chunk Read(const string& str) const;
+
+        uint32_t Size() const;
 
     private:
         string filename;
         unordered_map<string, FAT> fat;
         uint32_t count_items = 0;
-        up<ByteVectorReader> stream;
-        vector<u8> fileContent;
-        string key;
-        vector<u8> body;
+        MappedFile archive;
+    };
+
+    /* frame entry of the ICN header table */
+    struct icn_frame_t
+    {
+        u16 offsetX;
+        u16 offsetY;
+        u16 width;
+        u16 height;
+        u8 type;
+        uint32_t offset; // pixel data from the chunk start
+        uint32_t size;
+    };
+
+    /* pre-decoded frames written by the fheroes2-atlas tool, mapped read-only next to heroes2.agg
+     * header: magic, version, heroes2.agg and heroes2x.agg sizes, icn count
+     * icn directory: frames offset, frames count (tiles are raw palette indexes in the archive already)
+     * frame: offsetX, offsetY, width, height, type, pixels offset: width * height palette indexes, then as many
+     * mask bytes (0 transparent, 1 color, 2 shadow) */
+    class Atlas
+    {
+    public:
+        enum
+        {
+            MAGIC = 0x54413248, // H2AT
+            VERSION = 2,
+            HEADER_SIZE = 20,
+            ICN_ENTRY_SIZE = 8,
+            FRAME_SIZE = 16
+        };
+
+        enum
+        {
+            MASK_NONE,
+            MASK_COLOR,
+            MASK_SHADOW
+        };
+
+        bool Open(const string&, uint32_t aggSize, uint32_t aggxSize);
+
+        bool isGood() const;
+
+        void Close();
+
+        uint32_t ICNCount(int icn) const;
+
+        // pixels and mask point into the mapped file
+        bool ICNFrame(int icn, uint32_t index, icn_frame_t&, const u8*& pixels, const u8*& mask) const;
+
+    private:
+        MappedFile file;
+        uint32_t icns = 0;
     };
 
     struct icn_cache_t
     {
-        icn_cache_t() : sprites(nullptr), reflect(nullptr), count(0)
+        icn_cache_t() : sprites(nullptr), reflect(nullptr), count(0), parsed(false)
         {
         }
 
         Sprite* sprites;
         Sprite* reflect;
         uint32_t count;
+
+        // header table parsed once, frames point into body
+        bool parsed;
+        Chunk body;
+        vector<icn_frame_t> frames;
+
+        // cache nodes of sprites, then of reflect
+        vector<uint32_t> lru;
     };
 
     struct til_cache_t
@@ -74,11 +168,92 @@ namespace AGG
 
         Surface* sprites;
         uint32_t count;
+
+        // cache nodes of the rotated tiles, the original tiles are decoded at once and stay
+        vector<uint32_t> lru;
     };
 
     struct fnt_cache_t
     {
+        fnt_cache_t() : lru(0)
+        {
+        }
+
         Surface sfs[6]; /* small_white, small_yellow, medium_white, medium_yellow */
+        uint32_t lru;
+    };
+
+    enum
+    {
+        CACHE_ICN,
+        CACHE_TIL,
+        CACHE_FNT,
+        CACHE_TYPES
+    };
+
+    /* decoded surface in the LRU list of the sprite cache, node 0 is the list head */
+    struct lru_node_t
+    {
+        lru_node_t() : type(CACHE_ICN), id(0), index(0), bytes(0), prev(0), next(0)
+        {
+        }
+
+        int type;
+        uint32_t id;
+        uint32_t index;
+        uint32_t bytes;
+        uint32_t prev;
+        uint32_t next;
+    };
+
+    struct cache_stats_t
+    {
+        cache_stats_t() : hits(0), misses(0), evictions(0), entries(0), bytes(0), prefetched(0), wav(0), mid(0)
+        {
+            fill(types, types + CACHE_TYPES, 0);
+        }
+
+        uint32_t hits;
+        uint32_t misses;
+        uint32_t evictions;
+        uint32_t entries;
+        uint32_t bytes;
+        uint32_t prefetched;
+        uint32_t types[CACHE_TYPES]; // bytes of the LRU surfaces by cache type
+        uint32_t wav; // converted sounds, never evicted
+        uint32_t mid; // converted music, never evicted
+    };
+
+    /* frame decoded by a prefetch worker, the body stays mapped until Quit */
+    struct prefetch_job_t
+    {
+        prefetch_job_t() : icn(0), index(0)
+        {
+        }
+
+        int icn;
+        uint32_t index;
+        Chunk body;
+        icn_frame_t frame;
+        vector<u8> pixels; // palette index and mask planes, the surfaces are made on the main thread
+        vector<u8> mask;
+    };
+
+    /* queue and done list are shared with the workers under lock, pending is main thread only */
+    struct prefetch_pool_t
+    {
+        prefetch_pool_t() : ready(0), stop(false)
+        {
+        }
+
+        deque<prefetch_job_t> queue;
+        vector<prefetch_job_t> done;
+        unordered_set<uint32_t> pending;
+        vector<SDL::Thread> workers;
+        SDL::Mutex lock;
+        SDL::Semaphore jobs;
+        atomic<uint32_t> ready;
+        atomic<bool> stop;
     };
 
     struct loop_sound_t
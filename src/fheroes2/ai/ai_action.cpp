@@ -35,6 +35,7 @@
 #include "game_interface.h"
 #include "ai.h"
 #include "rand.h"
+#include "battle_simulator.h"
 
 void AIToMonster(Heroes& hero, uint32_t obj, s32 dst_index);
 
@@ -120,6 +121,25 @@ void AIToCoast(Heroes& hero, uint32_t obj, s32 dst_index);
 
 void AIMeeting(Heroes& hero1, Heroes& hero2);
 
+bool AIArmyWinsBattle(const Army& army, const Army& enemy, s32 index)
+{
+    if (!Settings::Get().ExtBattleAIEstimateOutcome())
+        return Army::TroopsStrongerEnemyTroops(army.m_troops, enemy.m_troops);
+
+    // clear cases do not need the simulations
+    const uint32_t strength1 = army.m_troops.GetStrength();
+    const uint32_t strength2 = enemy.m_troops.GetStrength();
+    if (strength1 > 2 * strength2 || 2 * strength1 < strength2)
+        return strength1 > strength2;
+
+    // fixed count without a time budget: the same seed replays the same decisions on every host
+    const Battle::Estimate estimate = Battle::EstimateOutcome(army, enemy, index, 32);
+
+    return estimate.battles
+               ? 0.75 <= estimate.wins
+               : Army::TroopsStrongerEnemyTroops(army.m_troops, enemy.m_troops);
+}
+
 int AISelectPrimarySkill(Heroes& hero)
 {
     switch (hero.GetRace())
@@ -1876,7 +1896,7 @@ bool AI::HeroesValidObject(const Heroes& hero, s32 index)
         {
             Army enemy(tile);
             return !enemy.m_troops.IsValid()
-                || Army::TroopsStrongerEnemyTroops(army.m_troops, enemy.m_troops);
+                || AIArmyWinsBattle(army, enemy, index);
         }
         break;
 
@@ -1911,7 +1931,7 @@ bool AI::HeroesValidObject(const Heroes& hero, s32 index)
             // FIXME: AI skip visiting alliance
             if (hero.isFriends(hero2->GetColor())) return false;
             if (hero2->AllowBattle(false) &&
-                Army::TroopsStrongerEnemyTroops(army.m_troops, hero2->GetArmy().m_troops))
+                AIArmyWinsBattle(army, hero2->GetArmy(), index))
                 return true;
             break;
         }
@@ -1977,6 +1997,15 @@ void AI::HeroesMove(Heroes& hero)
     hero.SetMove(true);
 
     const Settings& conf = Settings::Get();
+
+    // no interface: walk the whole path at once
+    if (conf.Headless())
+    {
+        while (!hero.isFreeman() && hero.isEnableMove())
+            hero.Move(true);
+        return;
+    }
+
     Display& display = Display::Get();
     Cursor& cursor = Cursor::Get();
     Interface::Basic& I = Interface::Basic::Get();
@@ -43,6 +43,8 @@
 
 #define HERO_MAX_SHEDULED_TASK 7
 
+void AIRedrawTurnProgress(uint32_t);
+
 AIHeroes& AIHeroes::Get()
 {
     static AIHeroes ai_heroes;
@@ -185,7 +187,7 @@ bool AIHeroesPriorityObject(const Heroes& hero, s32 index)
     return false;
 }
 
-s32 FindUncharteredTerritory(Heroes& hero, uint32_t scoute)
+s32 FindUncharteredTerritory(Heroes& hero, uint32_t scoute, const Route::ReachMap& reach)
 {
     Maps::Indexes v;
     Maps::GetAroundIndexes(hero.GetIndex(), scoute, true, v);
@@ -201,7 +203,7 @@ s32 FindUncharteredTerritory(Heroes& hero, uint32_t scoute)
         // find fogs
         if (world.GetTiles(*it).isFog(hero.GetColor()) &&
             world.GetTiles(*it).isPassable(&hero, Direction::CENTER, true) &&
-            hero.GetPath().Calculate(*it))
+            reach.isReachable(*it))
             res.push_back(*it);
     }
 
@@ -210,7 +212,7 @@ s32 FindUncharteredTerritory(Heroes& hero, uint32_t scoute)
     return result;
 }
 
-s32 GetRandomHeroesPosition(Heroes& hero, uint32_t scoute)
+s32 GetRandomHeroesPosition(Heroes& hero, uint32_t scoute, const Route::ReachMap& reach)
 {
     Maps::Indexes v;
     Maps::GetAroundIndexes(hero.GetIndex(), scoute, true, v);
@@ -224,7 +226,7 @@ s32 GetRandomHeroesPosition(Heroes& hero, uint32_t scoute)
     for (auto it = v.rbegin(); it != v.rend() && res.size() < 4; ++it)
     {
         if (world.GetTiles(*it).isPassable(&hero, Direction::CENTER, true) &&
-            hero.GetPath().Calculate(*it))
+            reach.isReachable(*it))
             res.push_back(*it);
     }
 
@@ -233,7 +235,7 @@ s32 GetRandomHeroesPosition(Heroes& hero, uint32_t scoute)
     return result;
 }
 
-void AIHeroesAddedRescueTask(Heroes& hero)
+void AIHeroesAddedRescueTask(Heroes& hero, const Route::ReachMap& reach)
 {
     AIHero& ai_hero = AIHeroes::Get(hero);
     Queue& task = ai_hero.sheduled_visit;
@@ -259,7 +261,7 @@ void AIHeroesAddedRescueTask(Heroes& hero)
     }
 
     // find unchartered territory
-    s32 index = FindUncharteredTerritory(hero, scoute);
+    s32 index = FindUncharteredTerritory(hero, scoute, reach);
     const Maps::Tiles& tile = world.GetTiles(hero.GetIndex());
 
     if (index < 0)
@@ -273,14 +275,14 @@ void AIHeroesAddedRescueTask(Heroes& hero)
         else
         {
             // random
-            index = GetRandomHeroesPosition(hero, scoute);
+            index = GetRandomHeroesPosition(hero, scoute, reach);
         }
     }
 
     if (0 <= index) task.push_back(index);
 }
 
-void AIHeroesAddedTask(Heroes& hero)
+void AIHeroesAddedTask(Heroes& hero, const Route::ReachMap& reach)
 {
     AIHero& ai_hero = AIHeroes::Get(hero);
     AIKingdom& ai_kingdom = AIKingdoms::Get(hero.GetColor());
@@ -326,7 +328,7 @@ void AIHeroesAddedTask(Heroes& hero)
         const bool validobj = AI::HeroesValidObject(hero, (*it).first);
 
         if (validobj &&
-            hero.GetPath().Calculate((*it).first))
+            reach.isReachable((*it).first))
         {
             task.push_back((*it).first);
             ai_objects.erase((*it).first);
@@ -337,7 +339,7 @@ void AIHeroesAddedTask(Heroes& hero)
     }
 
     if (task.empty())
-        AIHeroesAddedRescueTask(hero);
+        AIHeroesAddedRescueTask(hero, reach);
 }
 
 void AI::HeroesActionNewPosition(Heroes& hero)
@@ -489,12 +491,17 @@ bool AI::HeroesGetTask(Heroes& hero)
         if (hero.GetPath().isValid()) return true;
     }
 
+    // move costs to all tiles, one pass for the candidates below
+    Route::ReachMap reach;
+    reach.Calculate(hero);
+
     // scan heroes and castle
     const Maps::Indexes& enemies = Maps::ScanAroundObjects(hero.GetIndex(), hero.GetScoute(), objs3);
 
     for (int enemie : enemies)
     {
-        if (!AIHeroesPriorityObject(hero, enemie) || !hero.GetPath().Calculate(enemie))
+        if (!reach.isReachable(enemie) || !AIHeroesPriorityObject(hero, enemie) ||
+            !hero.GetPath().Calculate(enemie))
             continue;
 
         ai_hero.primary_target = enemie;
@@ -540,7 +547,7 @@ bool AI::HeroesGetTask(Heroes& hero)
     if (task.empty())
     {
         // get task from kingdom
-        AIHeroesAddedTask(hero);
+        AIHeroesAddedTask(hero, reach);
     }
     else
     {
@@ -602,25 +609,23 @@ void AIHeroesTurn(Heroes* hero)
 
 void AI::HeroesTurn(Heroes& hero)
 {
-    Interface::StatusWindow& status = Interface::Basic::Get().GetStatusWindow();
-
     while (hero.MayStillMove() &&
         !hero.Modes(HEROES_WAITING | HEROES_STUPID))
     {
         // turn indicator
-        status.RedrawTurnProgress(3);
+        AIRedrawTurnProgress(3);
 
         // get task for heroes
         HeroesGetTask(hero);
 
         // turn indicator
-        status.RedrawTurnProgress(5);
+        AIRedrawTurnProgress(5);
 
         // heroes AI turn
         HeroesMove(hero);
 
         // turn indicator
-        status.RedrawTurnProgress(7);
+        AIRedrawTurnProgress(7);
     }
 }
 
@@ -29,6 +29,7 @@
 
 #include <functional>
 #include <algorithm>
+#include <iostream>
 #include "settings.h"
 #include "game_interface.h"
 #include "heroes.h"
@@ -38,6 +39,8 @@
 #include "ai.h"
 #include "ai_simple.h"
 #include "mus.h"
+#include "system.h"
+#include "profiler.h"
 
 void AICastleTurn(Castle*);
 
@@ -60,6 +63,13 @@ AIKingdom& AIKingdoms::Get(int color)
     return Get()._items.at(Color::GetIndex(color));
 }
 
+/* turn indicator, skipped by the headless simulator */
+void AIRedrawTurnProgress(uint32_t progress)
+{
+    if (!Settings::Get().Headless())
+        Interface::Basic::Get().GetStatusWindow().RedrawTurnProgress(progress);
+}
+
 void AIKingdoms::Reset()
 {
     AIKingdoms& ai = Get();
@@ -78,15 +88,22 @@ void IndexObjectMap::DumpObjects(const IndexDistance& id)
 
 void WorldStoreObjects(int color, IndexObjectMap& store)
 {
-    const auto worldSize = world.w() * world.h();
-    for (s32 it = 0; it < worldSize; ++it)
+    // object groups of interest, the world keeps their tiles indexed
+    static const vector<int> objects = []
     {
-        const Maps::Tiles& tile = world.GetTiles(it);
-        if (tile.isFog(color)) continue;
-
-        if (MP2::isGroundObject(tile.GetObject()) ||
-            MP2::isWaterObject(tile.GetObject()) || MP2::OBJ_HEROES == tile.GetObject())
+        vector<int> res;
+        for (int object = 0; object < 256; ++object)
+            if (MP2::isGroundObject(object) || MP2::isWaterObject(object) || MP2::OBJ_HEROES == object)
+                res.push_back(object);
+        return res;
+    }();
+
+    for (const int object : objects)
+        for (const s32 it : world.vec_objects.Get(object))
         {
+            const Maps::Tiles& tile = world.GetTiles(it);
+            if (tile.isFog(color)) continue;
+
             // if quantity object is empty
             if (MP2::isQuantityObject(tile.GetObject()) &&
                 !MP2::isPickupObject(tile.GetObject()) && !tile.QuantityIsValid())
@@ -118,11 +135,11 @@ void WorldStoreObjects(int color, IndexObjectMap& store)
 
             store[it] = tile.GetObject();
         }
-    }
 }
 
 void AI::KingdomTurn(Kingdom& kingdom)
 {
+    PROFILE_SCOPE("AI::KingdomTurn");
     KingdomHeroes& heroes = kingdom.GetHeroes();
     KingdomCastles& castles = kingdom.GetCastles();
 
@@ -136,11 +153,10 @@ void AI::KingdomTurn(Kingdom& kingdom)
 
     if (!Settings::Get().MusicMIDI()) AGG::PlayMusic(MUS::COMPUTER);
 
-    Interface::StatusWindow& status = Interface::Basic::Get().GetStatusWindow();
     AIKingdom& ai = AIKingdoms::Get(color);
 
     // turn indicator
-    status.RedrawTurnProgress(0);
+    AIRedrawTurnProgress(0);
 
     // scan map
     ai.scans.clear();
@@ -168,7 +184,7 @@ void AI::KingdomTurn(Kingdom& kingdom)
     }
 
     // turn indicator
-    status.RedrawTurnProgress(1);
+    AIRedrawTurnProgress(1);
 
     // castles AI turn
     for_each(castles._items.begin(), castles._items.end(), [](auto* castle) { AICastleTurn(castle); });
@@ -293,7 +309,7 @@ void AI::KingdomTurn(Kingdom& kingdom)
     }
 
     // turn indicator
-    status.RedrawTurnProgress(2);
+    AIRedrawTurnProgress(2);
 
     // heroes turns
     for_each(heroes._items.begin(), heroes._items.end(), [](Heroes* hero) { AIHeroesTurn(hero); });
@@ -301,6 +317,9 @@ void AI::KingdomTurn(Kingdom& kingdom)
     for_each(heroes._items.begin(), heroes._items.end(), [](Heroes* hero) { AIHeroesTurn(hero); });
     for_each(heroes._items.begin(), heroes._items.end(), [](Heroes* hero) { AIHeroesEnd(hero); });
 
+    if (IS_DEBUG(DBG_AI, DBG_INFO))
+        H2VERBOSE(Color::String(color) << " path cache, " << Route::PathCacheStats());
+
     // turn indicator
-    status.RedrawTurnProgress(9);
+    AIRedrawTurnProgress(9);
 }
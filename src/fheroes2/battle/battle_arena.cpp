@@ -42,6 +42,7 @@
 #include "m82.h"
 #include "mus.h"
 #include "rand.h"
+#include "profiler.h"
 
 #include "icn.h"
 #include "audio_mixer.h"
@@ -50,7 +51,8 @@
 
 namespace Battle
 {
-    Arena* arena = nullptr;
+    // per thread, outcome estimates run arenas in parallel
+    thread_local Arena* arena = nullptr;
 }
 
 int GetCovr(int ground)
@@ -224,6 +226,11 @@ Battle::Arena::Arena(Army& a1, Army& a2, s32 index, bool local) :
     // init interface
     if (local && !conf.QuickCombat())
     {
+        // decode the troops animation while the interface loads
+        for (const Force* force : {army1.get(), army2.get()})
+            for (const Unit* unit : force->_items)
+                AGG::Prefetch(unit->GetMonsterSprite().icn_file);
+
         interface = std::make_unique<Interface>(*this, index);
         board.SetArea(interface->GetArea());
 
@@ -386,7 +393,7 @@ void Battle::Arena::TurnTroop(Unit* current_troop)
 
         board.Reset();
 
-        DELAY(10);
+        if (interface) DELAY(10);
     }
 }
 
@@ -398,6 +405,7 @@ bool Battle::Arena::BattleValid() const
 
 void Battle::Arena::Turns()
 {
+    PROFILE_SCOPE("Battle::Arena::Turns");
     const Settings& conf = Settings::Get();
 
     ++current_turn;
@@ -503,13 +511,13 @@ void Battle::Arena::RemoteTurn(const Unit& b, Actions& a)
 
 void Battle::Arena::HumanTurn(const Unit& b, Actions& a)
 {
-    if (Settings::Get().QuickCombat())
+    // without interface (simulations) the AI plays for everybody
+    if (Settings::Get().QuickCombat() || !interface)
     {
         AI::BattleTurn(*this, b, a);
         return;
     }
-    if (interface)
-        interface->HumanTurn(b, a);
+    interface->HumanTurn(b, a);
 }
 
 void Battle::Arena::TowerAction(const Tower& twr)
@@ -24,7 +24,7 @@
 #include <iterator>
 #include <functional>
 #include <algorithm>
-#include <unordered_map>
+#include <array>
 #include <sstream>
 #include "world.h"
 #include "ground.h"
@@ -156,80 +156,143 @@ void Battle::Board::SetScanPassability(const Unit& b)
     }
 }
 
-struct bcell_t
+namespace
 {
-    s32 cost;
-    s32 prnt;
-    bool open;
+    struct bcell_t
+    {
+        s32 cost;
+        s32 prnt;
+        bool open;
+
+        bcell_t() : cost(MAXU16), prnt(-1), open(true)
+        {
+        }
+    };
+
+    /* open set entry, ties resolved by first touch order */
+    struct bopen_t
+    {
+        s32 cost;
+        s32 order;
+        s32 index;
+
+        bool operator>(const bopen_t& other) const
+        {
+            return cost != other.cost ? cost > other.cost : order > other.order;
+        }
+    };
+
+    struct blinks_t
+    {
+        s32 count;
+        s32 cells[6];
+
+        blinks_t() : count(0), cells{}
+        {
+        }
+
+        void Set(const Battle::Indexes& indexes)
+        {
+            count = 0;
+            for (const s32 index : indexes)
+                if (count < 6) cells[count++] = index;
+        }
+    };
+
+    /* per cell neighbours: narrow troops, and wide troops for both orientations */
+    struct bneighbours_t
+    {
+        array<blinks_t, ARENASIZE> around;
+        array<blinks_t, ARENASIZE> wide[2];
+
+        bneighbours_t()
+        {
+            for (s32 index = 0; index < ARENASIZE; ++index)
+            {
+                around[index].Set(Battle::Board::GetAroundIndexes(index));
+                wide[0][index].Set(Battle::Board::GetMoveWideIndexes(index, false));
+                wide[1][index].Set(Battle::Board::GetMoveWideIndexes(index, true));
+            }
+        }
+    };
 
-    bcell_t() : cost(MAXU16), prnt(-1), open(true)
+    const bneighbours_t& GetBoardNeighbours()
     {
+        static const bneighbours_t neighbours;
+        return neighbours;
     }
-};
+}
 
 Battle::Indexes Battle::Board::GetAStarPath(const Unit& b, const Position& dst, bool debug)
 {
     const Castle* castle = Arena::GetCastle();
     const Bridge* bridge = Arena::GetBridge();
-    unordered_map<s32, bcell_t> listCells;
+    const bool moat = castle && castle->isBuild(BUILD_MOAT);
+    const bool wide = b._monster.isWide();
+    const s32 target = dst.GetHead()->GetIndex();
+    const bneighbours_t& neighbours = GetBoardNeighbours();
+
+    array<bcell_t, ARENASIZE> listCells;
+    // every relaxation pushes at most one entry
+    array<bopen_t, ARENASIZE * 6 + 1> openCells;
+    size_t openSize = 0;
+    s32 order = 0;
     s32 cur = b.GetHeadIndex();
 
+    if (!isValidIndex(cur) || !isValidIndex(target))
+        return Indexes();
+
     listCells[cur].prnt = -1;
     listCells[cur].cost = 0;
     listCells[cur].open = false;
 
-
-    while (cur != dst.GetHead()->GetIndex())
+    while (cur != target)
     {
-        const Cell& center = _items.at(cur);
-        Indexes around = b._monster.isWide()
-                             ? GetMoveWideIndexes(cur,
-                                                  0 > listCells[cur].prnt
-                                                      ? b.isReflect()
-                                                      : RIGHT_SIDE & GetDirection(cur,
-                                                                                  listCells[cur].prnt))
-                             : GetAroundIndexes(cur);
-
-        for (const auto& it : around)
+        const Cell& center = _items[cur];
+        const blinks_t& around = wide
+                                     ? neighbours.wide[0 > listCells[cur].prnt
+                                                           ? b.isReflect()
+                                                           : 0 != (RIGHT_SIDE & GetDirection(cur, listCells[cur].prnt))][cur]
+                                     : neighbours.around[cur];
+
+        for (s32 ii = 0; ii < around.count; ++ii)
         {
-            Cell& cell = _items.at(it);
+            const s32 it = around.cells[ii];
+            bcell_t& next = listCells[it];
 
-            if (!listCells[it].open || !cell.isPassable4(b, center) ||
+            if (!next.open || !_items[it].isPassable4(b, center) ||
                 (bridge && isBridgeIndex(it) && !bridge->isPassable(b.GetColor())))
                 continue;
-            const s32 cost = 100 * GetDistance(it, dst.GetHead()->GetIndex()) +
-                (b._monster.isWide() && WideDifficultDirection(center.GetDirection(), GetDirection(it, cur))
-                     ? 100
-                     : 0) +
-                (castle && castle->isBuild(BUILD_MOAT) && isMoatIndex(it) ? 100 : 0);
-
-            // new cell
-            if (0 > listCells[it].prnt)
+            const s32 cost = listCells[cur].cost + 100 * GetDistance(it, target) +
+                (wide && WideDifficultDirection(center.GetDirection(), GetDirection(it, cur)) ? 100 : 0) +
+                (moat && isMoatIndex(it) ? 100 : 0);
+
+            // new cell or change parent
+            if (0 > next.prnt || next.cost > cost)
             {
-                listCells[it].prnt = cur;
-                listCells[it].cost = cost + listCells[cur].cost;
+                next.prnt = cur;
+                next.cost = cost;
+                openCells[openSize++] = bopen_t{cost, order++, it};
+                push_heap(openCells.begin(), openCells.begin() + openSize, greater<bopen_t>());
             }
-            else
-                // change parent
-                if (listCells[it].cost > cost + listCells[cur].cost)
-                {
-                    listCells[it].prnt = cur;
-                    listCells[it].cost = cost + listCells[cur].cost;
-                }
         }
 
         listCells[cur].open = false;
-        s32 cost = MAXU16;
+        cur = -1;
 
-        // find min cost opens
-        for (const auto& listCell : listCells)
+        // find min cost opens, skip outdated entries
+        while (openSize)
         {
-            if (!listCell.second.open || cost <= listCell.second.cost)
-                continue;
-            cur = listCell.first;
-            cost = listCell.second.cost;
+            pop_heap(openCells.begin(), openCells.begin() + openSize, greater<bopen_t>());
+            const bopen_t& top = openCells[--openSize];
+
+            if (listCells[top.index].open && listCells[top.index].cost == top.cost)
+            {
+                cur = top.index;
+                break;
+            }
         }
-        if (MAXU16 == cost) break;
+        if (0 > cur) break;
     }
 
     Indexes result;
@@ -47,6 +47,8 @@ namespace Battle
 
 Battle::Result Battle::Loader(Army& army1, Army& army2, s32 mapsindex)
 {
+    const Rand::Stream stream(Rand::BATTLE);
+
     // pre battle army1
     if (army1.GetCommander())
     {
@@ -0,0 +1,465 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include "system.h"
+#include "tools.h"
+#include "thread.h"
+#include "settings.h"
+#include "world.h"
+#include "castle.h"
+#include "heroes.h"
+#include "captain.h"
+#include "rand.h"
+#include "payment.h"
+#include "race.h"
+#include "monster.h"
+#include "battle_arena.h"
+#include "battle_simulator.h"
+
+namespace
+{
+    string SimulatorName(string name)
+    {
+        name = StringLower(name);
+        name.erase(remove_if(name.begin(), name.end(),
+                             [](char ch) { return ' ' == ch || '_' == ch || '-' == ch; }), name.end());
+        return name;
+    }
+
+    int SimulatorRace(const string& name)
+    {
+        const string key = SimulatorName(name);
+
+        for (int race = Race::KNGT; race <= Race::NECR; race <<= 1)
+            if (SimulatorName(Race::String(race)) == key) return race;
+        return Race::NONE;
+    }
+
+    int SimulatorMonster(const string& name)
+    {
+        const string key = SimulatorName(name);
+
+        for (int id = Monster::PEASANT; id <= Monster::WATER_ELEMENT; ++id)
+            if (SimulatorName(Monster(id).GetName()) == key) return id;
+        return Monster::UNKNOWN;
+    }
+
+    struct EstimateBattle
+    {
+        bool done;
+        bool wins;
+        double loss1;
+        double loss2;
+    };
+
+    struct EstimateJob
+    {
+        const Army* army1;
+        const Army* army2;
+        s32 index;
+        uint32_t seed;
+        uint32_t budget;
+        SDL::Time time;
+        atomic<uint32_t> next;
+        vector<EstimateBattle> results;
+    };
+
+    /* commanders are copied too, so spent spell points stay in the simulation */
+    HeroBase* EstimateCommander(const HeroBase* commander)
+    {
+        if (commander && commander->isHeroes())
+        {
+            const Heroes& from = static_cast<const Heroes&>(*commander);
+            auto* hero = new Heroes();
+
+            hero->CopyBattleState(from);
+            hero->SetColor(from.GetColor());
+            hero->name = from.name;
+            hero->experience = from.experience;
+            hero->secondary_skills = from.secondary_skills;
+            hero->hid = from.hid;
+            hero->portrait = from.portrait;
+            hero->race = from.race;
+            return hero;
+        }
+
+        if (commander && commander->isCaptain())
+        {
+            auto* captain = new Captain(const_cast<Castle&>(*commander->inCastle()));
+
+            captain->CopyBattleState(*commander);
+            return captain;
+        }
+
+        return nullptr;
+    }
+
+    // a hero copy fights with its own army, so the summoned units never see the live one
+    Army& EstimateArmy(Army& army, HeroBase* commander, const Army& from)
+    {
+        Army& result = commander && commander->isHeroes() ? commander->GetArmy() : army;
+
+        result.m_troops.Assign(from.m_troops);
+        result.SetColor(from.GetColor());
+        result.SetSpreadFormat(from.isSpreadFormat());
+        return result;
+    }
+
+    void EstimateRun(const EstimateJob& job, uint32_t battle, EstimateBattle& result)
+    {
+        unique_ptr<HeroBase> commander1(EstimateCommander(job.army1->GetCommander()));
+        unique_ptr<HeroBase> commander2(EstimateCommander(job.army2->GetCommander()));
+        Army spare1(commander1.get());
+        Army spare2(commander2.get());
+        Army& army1 = EstimateArmy(spare1, commander1.get(), *job.army1);
+        Army& army2 = EstimateArmy(spare2, commander2.get(), *job.army2);
+
+        const uint32_t strength1 = army1.m_troops.GetStrength();
+        const uint32_t strength2 = army2.m_troops.GetStrength();
+
+        // every battle has its own stream: without a time budget the results do not depend on the threads count
+        Rand::SetThreadSeed((job.seed ^ (battle * 2654435761u)) | 1);
+        {
+            Battle::Arena arena(army1, army2, job.index, false);
+
+            while (arena.BattleValid())
+                arena.Turns();
+
+            result.wins = 0 != (arena.GetResult().army1 & Battle::RESULT_WINS);
+            arena.GetForce1().SyncArmyCount();
+            arena.GetForce2().SyncArmyCount();
+        }
+
+        result.loss1 = strength1 ? 1.0 - static_cast<double>(army1.m_troops.GetStrength()) / strength1 : 0;
+        result.loss2 = strength2 ? 1.0 - static_cast<double>(army2.m_troops.GetStrength()) / strength2 : 0;
+        result.done = true;
+    }
+
+    int EstimateWorker(void* param)
+    {
+        EstimateJob& job = *static_cast<EstimateJob*>(param);
+
+        for (uint32_t battle = job.next++; battle < job.results.size(); battle = job.next++)
+        {
+            if (job.budget)
+            {
+                SDL::Time time = job.time;
+                time.Stop();
+                if (time.Get() >= job.budget) break;
+            }
+
+            EstimateRun(job, battle, job.results[battle]);
+        }
+
+        Rand::SetThreadSeed(0);
+        return 0;
+    }
+
+    void SimulatorTroops(Army& army, const Battle::SimulatorArmy& spec)
+    {
+        army.m_troops.Clean();
+
+        for (const auto& troop : spec.troops)
+            army.m_troops.JoinTroop(Monster(troop.first), troop.second);
+    }
+}
+
+Battle::SimulatorArmy::SimulatorArmy() : race(Race::NONE), attack(-1), defense(-1), power(-1), knowledge(-1)
+{
+}
+
+bool Battle::SimulatorArmy::Parse(const string& spec)
+{
+    *this = SimulatorArmy();
+
+    for (const string& token : StringSplit(spec, ","))
+    {
+        if (0 == token.compare(0, 5, "hero="))
+        {
+            const vector<string> fields = StringSplit(token.substr(5), "/");
+
+            race = fields.empty() ? Race::NONE : SimulatorRace(fields.front());
+            if (Race::NONE == race || (1 != fields.size() && 5 != fields.size()))
+            {
+                H2ERROR("unknown hero: " << token);
+                return false;
+            }
+
+            if (5 == fields.size())
+            {
+                attack = GetInt(fields[1]);
+                defense = GetInt(fields[2]);
+                power = GetInt(fields[3]);
+                knowledge = GetInt(fields[4]);
+            }
+        }
+        else if (!token.empty())
+        {
+            const size_t pos = token.find(':');
+            const int monster = SimulatorMonster(token.substr(0, pos));
+            const int count = string::npos != pos ? GetInt(token.substr(pos + 1)) : 0;
+
+            if (Monster::UNKNOWN == monster || 0 >= count || ARMYMAXTROOPS <= troops.size())
+            {
+                H2ERROR("unknown troop: " << token);
+                return false;
+            }
+
+            troops.emplace_back(monster, count);
+        }
+    }
+
+    return !troops.empty();
+}
+
+string Battle::SimulatorArmy::String() const
+{
+    ostringstream os;
+
+    if (Race::NONE != race)
+    {
+        os << Race::String(race) << " hero";
+        if (0 <= attack)
+            os << " (" << attack << "/" << defense << "/" << power << "/" << knowledge << ")";
+        os << ": ";
+    }
+
+    for (auto it = troops.begin(); it != troops.end(); ++it)
+        os << (it != troops.begin() ? ", " : "") << it->second << " " << Monster(it->first).GetMultiName();
+
+    return os.str();
+}
+
+Battle::SimulatorStats::SimulatorStats() : battles(0), wins1(0), wins2(0), turns(0), time(0)
+{
+}
+
+string Battle::SimulatorStats::String() const
+{
+    ostringstream os;
+    const uint32_t count = max(battles, 1u);
+
+    os << "battles: " << battles <<
+        ", attacker wins: " << 100 * wins1 / count << "%" <<
+        ", defender wins: " << 100 * wins2 / count << "%" <<
+        ", average turns: " << static_cast<double>(turns) / count <<
+        ", time: " << time << " ms" <<
+        ", battles per second: " << (time ? 1000.0 * battles / time : 0);
+
+    return os.str();
+}
+
+Battle::Estimate::Estimate() : battles(0), wins(0), loss1(0), loss2(0)
+{
+}
+
+string Battle::Estimate::String() const
+{
+    ostringstream os;
+
+    os << "battles: " << battles << ", wins: " << wins << ", losses: " << loss1 << "/" << loss2;
+
+    return os.str();
+}
+
+uint32_t Battle::EstimateThreads()
+{
+    return max(1u, thread::hardware_concurrency());
+}
+
+Battle::Estimate Battle::EstimateOutcome(const Army& army1, const Army& army2, s32 index, uint32_t count,
+                                         uint32_t budget)
+{
+    if (!count) return Estimate();
+
+    EstimateJob job;
+    job.army1 = &army1;
+    job.army2 = &army2;
+    job.index = index;
+    job.seed = Rand::Get(1, 0x7FFFFFFF);
+    job.budget = budget;
+    job.next = 0;
+    job.results.assign(count, EstimateBattle{false, false, 0, 0});
+    job.time.Start();
+
+    // the calling thread works as well
+    vector<SDL::Thread> workers(min(EstimateThreads(), count) - 1);
+
+    for (auto& worker : workers)
+        worker.Create(EstimateWorker, &job);
+    EstimateWorker(&job);
+    for (auto& worker : workers)
+        worker.Wait();
+
+    Estimate result;
+
+    for (const EstimateBattle& battle : job.results)
+    {
+        if (!battle.done) continue;
+        ++result.battles;
+        result.wins += battle.wins;
+        result.loss1 += battle.loss1;
+        result.loss2 += battle.loss2;
+    }
+
+    if (result.battles)
+    {
+        result.wins /= result.battles;
+        result.loss1 /= result.battles;
+        result.loss2 /= result.battles;
+    }
+
+    return result;
+}
+
+Battle::Simulator::Simulator() : castle(Race::NONE)
+{
+}
+
+Battle::SimulatorStats Battle::Simulator::Run(uint32_t count)
+{
+    SimulatorStats stats;
+    SDL::Time time;
+
+    time.Start();
+    for (uint32_t ii = 0; ii < count; ++ii)
+        RunBattle(stats);
+    time.Stop();
+
+    stats.time = time.Get();
+    return stats;
+}
+
+Battle::Estimate Battle::Simulator::RunEstimate(uint32_t count) const
+{
+    Army monsters;
+    Army* army1 = nullptr;
+    Army* army2 = nullptr;
+    s32 index = -1;
+
+    return Prepare(monsters, army1, army2, index) ? EstimateOutcome(*army1, *army2, index, count) : Estimate();
+}
+
+Heroes* Battle::Simulator::RecruitHero(const SimulatorArmy& spec, int color, const Point& center)
+{
+    Heroes* hero = Race::NONE != spec.race ? world.GetFreemanHeroes(spec.race) : nullptr;
+
+    if (hero && hero->Recruit(color, center))
+    {
+        if (0 <= spec.attack)
+        {
+            hero->attack = spec.attack;
+            hero->defense = spec.defense;
+            hero->power = spec.power;
+            hero->knowledge = spec.knowledge;
+        }
+
+        hero->SetSpellPoints(hero->GetMaxSpellPoints());
+        SimulatorTroops(hero->GetArmy(), spec);
+        return hero;
+    }
+
+    return nullptr;
+}
+
+bool Battle::Simulator::Prepare(Army& monsters, Army*& army1, Army*& army2, s32& index) const
+{
+    Settings& conf = Settings::Get();
+
+    // fresh world for every battle, the arena changes heroes and armies
+    world.NewMaps(10, 10);
+    conf.GetPlayers().Init(Color::BLUE | Color::RED);
+    world.InitKingdoms();
+
+    Players::SetPlayerRace(Color::BLUE, attacker.race);
+    Players::SetPlayerRace(Color::RED, Race::NONE != defender.race ? defender.race : castle);
+    Players::SetPlayerControl(Color::BLUE, CONTROL_AI);
+    Players::SetPlayerControl(Color::RED, CONTROL_AI);
+    conf.SetCurrentColor(Color::BLUE);
+
+    Heroes* hero1 = RecruitHero(attacker, Color::BLUE, Point(5, 5));
+    if (!hero1) return false;
+
+    army1 = &hero1->GetArmy();
+    army2 = &monsters;
+    index = hero1->GetIndex() + 1;
+
+    if (Race::NONE != castle)
+    {
+        auto town = new Castle(5, 4, castle);
+        Kingdom& kingdom = world.GetKingdom(Color::RED);
+
+        world.vec_castles._items.push_back(town);
+        town->ChangeColor(Color::RED);
+        kingdom.AddCastle(town);
+
+        for (uint32_t build : {BUILD_CASTLE, BUILD_MOAT, BUILD_LEFTTURRET, BUILD_RIGHTTURRET})
+        {
+            kingdom.AddFundsResource(PaymentConditions::BuyBuilding(castle, build));
+            town->SetModes(Castle::ALLOWCASTLE | Castle::ALLOWBUILD);
+            town->BuyBuilding(build);
+        }
+
+        // guest hero defends with his own army
+        Heroes* hero2 = RecruitHero(defender, Color::RED, town->GetCenter());
+        army2 = hero2 ? &hero2->GetArmy() : &town->GetArmy();
+        index = town->GetIndex();
+    }
+    else
+    {
+        Heroes* hero2 = RecruitHero(defender, Color::RED, Point(5, 6));
+        if (hero2) army2 = &hero2->GetArmy();
+    }
+
+    if (army2->GetCommander() == nullptr)
+        SimulatorTroops(*army2, defender);
+
+    return true;
+}
+
+void Battle::Simulator::RunBattle(SimulatorStats& stats) const
+{
+    Army monsters;
+    Army* army1 = nullptr;
+    Army* army2 = nullptr;
+    s32 index = -1;
+
+    if (!Prepare(monsters, army1, army2, index)) return;
+
+    Arena arena(*army1, *army2, index, false);
+
+    while (arena.BattleValid())
+        arena.Turns();
+
+    const Result& result = arena.GetResult();
+
+    ++stats.battles;
+    stats.turns += arena.GetCurrentTurn();
+    if (result.army1 & RESULT_WINS)
+        ++stats.wins1;
+    else if (result.army2 & RESULT_WINS)
+        ++stats.wins2;
+}
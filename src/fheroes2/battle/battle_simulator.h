@@ -0,0 +1,104 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "gamedefs.h"
+#include "rect.h"
+
+class Heroes;
+
+class Army;
+
+namespace Battle
+{
+    /* army description for the headless simulator: "hero=race[/A/D/P/K],monster:count,..." */
+    struct SimulatorArmy
+    {
+        SimulatorArmy();
+
+        bool Parse(const string&);
+
+        string String() const;
+
+        int race; // hero race, Race::NONE for an army without hero
+        int attack; // primary skills, -1 keeps the hero defaults
+        int defense;
+        int power;
+        int knowledge;
+        vector<pair<int, uint32_t>> troops;
+    };
+
+    struct SimulatorStats
+    {
+        SimulatorStats();
+
+        string String() const;
+
+        uint32_t battles;
+        uint32_t wins1;
+        uint32_t wins2;
+        uint32_t turns;
+        uint32_t time; // ms
+    };
+
+    /* Monte Carlo estimate of a battle between copies of two armies */
+    struct Estimate
+    {
+        Estimate();
+
+        string String() const;
+
+        uint32_t battles;
+        double wins; // probability that the first army wins
+        double loss1; // expected share of strength lost by the first army
+        double loss2;
+    };
+
+    uint32_t EstimateThreads();
+
+    // plays up to count battles on all cores, stops after budget ms (0: no limit)
+    Estimate EstimateOutcome(const Army&, const Army&, s32 index, uint32_t count, uint32_t budget = 0);
+
+    /* runs AI against AI battles without interface, sound or sprites */
+    class Simulator
+    {
+    public:
+        Simulator();
+
+        SimulatorStats Run(uint32_t count);
+
+        // the same setup played by EstimateOutcome on all cores
+        Estimate RunEstimate(uint32_t count) const;
+
+        SimulatorArmy attacker;
+        SimulatorArmy defender;
+        int castle; // defender castle race, Race::NONE for a field battle
+
+    private:
+        static Heroes* RecruitHero(const SimulatorArmy&, int color, const Point&);
+
+        bool Prepare(Army& monsters, Army*& army1, Army*& army2, s32& index) const;
+
+        void RunBattle(SimulatorStats&) const;
+    };
+}
@@ -492,6 +492,13 @@ void Castle::ChangeColor(int cl)
 {
     SetColor(cl);
     army.SetColor(cl);
+
+    // radar shows the castle tiles in its color, see isPosition
+    const Point& mp = GetCenter();
+    for (s32 yy = mp.y - 1; yy <= mp.y; ++yy)
+        for (s32 xx = mp.x - 2; xx <= mp.x + 2; ++xx)
+            if (Maps::isValidAbsPoint(xx, yy))
+                world.vec_changes.SetChanged(Maps::GetIndexFromAbsPoint(xx, yy));
 }
 
 // return mage guild level
@@ -220,6 +220,11 @@ int Castle::OpenDialog(bool readonly, bool fade)
 
     CastleHeroes heroes = world.GetHeroes(*this);
 
+    // decode the building animations during the fade
+    for (uint32_t build = 1; build; build <<= 1)
+        if (building & build)
+            AGG::Prefetch(GetICNBuilding(build, GetRace()));
+
     // cursor
     Cursor& cursor = Cursor::Get();
 
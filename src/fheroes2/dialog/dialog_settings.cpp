@@ -254,6 +254,7 @@ void Dialog::ExtSettings(bool readonly)
     states.push_back(Settings::BATTLE_MAGIC_TROOP_RESIST);
     states.push_back(Settings::BATTLE_SKIP_INCREASE_DEFENSE);
     states.push_back(Settings::BATTLE_REVERSE_WAIT_ORDER);
+    states.push_back(Settings::BATTLE_AI_ESTIMATE_OUTCOME);
 
     SettingsListBox listbox(area, readonly);
 
@@ -57,6 +57,7 @@ int PrintHelp(const char* basename)
 #ifndef BUILD_RELEASE
     COUT("  -d\tdebug mode");
 #endif
+    COUT("  -s\trandom seed, default current time");
     COUT("  -h\tprint this help and exit");
 
     return EXIT_SUCCESS;
@@ -129,10 +130,12 @@ int main(int argc, char **argv)
     InitHomeDir();
     ReadConfigs();
 
+    uint32_t seed = 0;
+
     // getopt
     {
         int opt;
-        while ((opt = System::GetCommandOptions(vArgv.size(), vArgv, "ht:d:")) != -1)
+        while ((opt = System::GetCommandOptions(vArgv.size(), vArgv, "hs:t:d:")) != -1)
             switch (opt)
             {
 #ifndef BUILD_RELEASE
@@ -144,6 +147,10 @@ int main(int argc, char **argv)
                 conf.SetDebug(System::GetOptionsArgument() ? GetInt(System::GetOptionsArgument()) : 0);
                 break;
 #endif
+            case 's':
+                seed = GetInt(System::GetOptionsArgument());
+                break;
+
             case '?':
             case 'h':
                 return PrintHelp(vArgv[0].c_str());
@@ -156,7 +163,7 @@ int main(int argc, char **argv)
     if (!conf.SelectVideoDriver().empty()) SetVideoDriver(conf.SelectVideoDriver());
 
     // random init
-    Rand::Init();
+    Rand::Init(seed);
     if (conf.Music()) SetTimidityEnvPath(conf);
 
     uint32_t subsystem = INIT_VIDEO | INIT_TIMER;
@@ -170,6 +170,7 @@ namespace Game
         EVENT_SHOWBUTTONS,
         EVENT_SHOWSTATUS,
         EVENT_SHOWICONS,
+        EVENT_SHOWPROFILER,
         EVENT_SWITCHGROUP,
         EVENT_EMULATETOGGLE,
         EVENT_LAST
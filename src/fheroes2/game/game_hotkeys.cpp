@@ -176,6 +176,8 @@ const char* Game::EventsName(int evnt)
         return "show status";
     case EVENT_SHOWICONS:
         return "show icons";
+    case EVENT_SHOWPROFILER:
+        return "show profiler";
     case EVENT_EMULATETOGGLE:
         return "emulate mouse toggle";
     case EVENT_SWITCHGROUP:
@@ -277,6 +279,8 @@ void Game::HotKeysDefaults()
     key_events[EVENT_SHOWBUTTONS] = KEY_3;
     key_events[EVENT_SHOWSTATUS] = KEY_4;
     key_events[EVENT_SHOWICONS] = KEY_5;
+    // turn profiler overlay
+    key_events[EVENT_SHOWPROFILER] = KEY_F12;
     // system:
     // emulate mouse
     // key_events[EVENT_EMULATETOGGLE] = KEY_NONE;
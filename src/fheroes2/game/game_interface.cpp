@@ -30,9 +30,11 @@
 #include "maps.h"
 #include "mp2.h"
 #include "world.h"
+#include "agg.h"
 #include "dialog.h"
 #include "game_interface.h"
 #include "system.h"
+#include "profiler.h"
 
 Interface::Basic::Basic() : gameArea(*this), radar(*this),
                             iconsPanel(*this), buttonsArea(*this),
@@ -197,6 +199,10 @@ void Interface::Basic::Redraw(int force)
         RedrawSystemInfo(conf.ExtGameHideInterface() ? 10 : 26,
                          Display::Get().h() - (conf.ExtGameHideInterface() ? 14 : 30), System::GetMemoryUsage());
 
+    // turn profiler overlay, over the fresh game area only
+    if (Profiler::isEnabled() && (redraw | force) & REDRAW_GAMEAREA)
+        RedrawProfiler();
+
     if ((redraw | force) & REDRAW_BORDER)
         GameBorderRedraw();
 
@@ -207,7 +213,9 @@ void Interface::Basic::RedrawSystemInfo(s32 cx, s32 cy, uint32_t usage)
 {
     ostringstream os;
 
-    os << "mem. usage: " << usage / 1024 << "Kb" << ", cur. time: ";
+    // the caches count their own bytes, no system call
+    os << "mem. usage: " << usage / 1024 << "Kb" << ", cache: " << AGG::GetCacheBytes().Total() / 1024 << "Kb" <<
+        ", cur. time: ";
 
     time_t rawtime;
     time(&rawtime);
@@ -221,6 +229,23 @@ void Interface::Basic::RedrawSystemInfo(s32 cx, s32 cy, uint32_t usage)
     system_info.Blit(cx, cy);
 }
 
+void Interface::Basic::RedrawProfiler() const
+{
+    const Rect& area = gameArea.GetArea();
+    istringstream is(Profiler::GetReport());
+    string line;
+    Text text;
+
+    text.Set(Font::YELLOW_SMALL);
+
+    // the last frame: the heaviest scopes come first
+    for (s32 posy = area.y + 10; posy + 10 < area.y + area.h && getline(is, line); posy += 10)
+    {
+        text.Set(line);
+        text.Blit(area.x + 10, posy);
+    }
+}
+
 s32 Interface::Basic::GetDimensionDoorDestination(s32 from, uint32_t distance, bool water) const
 {
     Cursor& cursor = Cursor::Get();
@@ -153,6 +153,8 @@ namespace Interface
 
         void EventSwitchShowControlPanel() const;
 
+        void EventSwitchShowProfiler();
+
         static void EventDebug1();
 
         static void EventDebug2();
@@ -190,6 +192,8 @@ namespace Interface
 
         void RedrawSystemInfo(s32, s32, uint32_t);
 
+        void RedrawProfiler() const;
+
         void ShowPathOrStartMoveHero(Heroes*, s32);
 
         void MoveHeroFromArrowKeys(Heroes& hero, int direct);
@@ -35,6 +35,7 @@
 #include "BinaryFileReader.h"
 #include <chrono>
 #include "system.h"
+#include "rand.h"
 
 static u16 SAV2ID2 = 0xFF02;
 static u16 SAV2ID3 = 0xFF03;
@@ -110,14 +111,36 @@ bool Game::Save(const string& fn)
     ByteVectorWriter bfz(226 * 1024);
     bfz.SetBigEndian(true);
     bfz << loadver << World::Get() << Settings::Get() <<
-        GameOver::Result::Get() << GameStatic::Data::Get() << MonsterStaticData::Get() << SAV2ID3;
+        GameOver::Result::Get() << GameStatic::Data::Get() << MonsterStaticData::Get() << Rand::GetState() << SAV2ID3;
     bfs << bfz.data();
     const auto savedFileData = bfs.data();
     FileUtils::writeFileBytes(fn, savedFileData);
     return true;
 }
 
-//#define OLDMETHOD
+namespace Game
+{
+    // saves start with the header, the browser reads only this prefix
+    const uint32_t SAV2HEADERSIZE = 4096;
+
+    bool ReadHeaderSAV(ByteVectorReader& fs, u16& binver, HeaderSAV& header)
+    {
+        fs.setBigEndian(true);
+        char major, minor;
+        fs >> major >> minor;
+
+        const u16 savid = static_cast<u16>(major) << 8 | static_cast<u16>(minor);
+
+        // check version sav file
+        if (savid != SAV2ID2 && savid != SAV2ID3)
+            return false;
+
+        string strver;
+        fs >> strver >> binver >> header;
+
+        return fs.tell() <= fs.size();
+    }
+}
 
 bool Game::Load(const string& fn)
 {
@@ -125,58 +148,36 @@ bool Game::Load(const string& fn)
     // loading info
     ShowLoadMapsText();
 
-    auto fileVector = FileUtils::readFileBytes(fn);
+    // one read, the header and the game data are views of this buffer
+    const vector<u8> fileVector = FileUtils::readFileBytes(fn);
     if (fileVector.empty())
     {
         return false;
     }
     ByteVectorReader byteFs(fileVector);
-    byteFs.setBigEndian(true);
-    char major, minor;
-
-    byteFs >> major >> minor;
 
-
-    const u16 savid = static_cast<u16>(major) << 8 | static_cast<u16>(minor);
-
-    // check version sav file
-    if (savid != SAV2ID2 && savid != SAV2ID3)
-    {
-        return false;
-    }
-
-    string strver;
     u16 binver = 0;
     HeaderSAV header;
 
     // read raw info
-    byteFs >> strver >> binver >> header;
-    const size_t offset = byteFs.tell();
-
+    if (!ReadHeaderSAV(byteFs, binver, header))
+    {
+        return false;
+    }
 
     if (header.status & HeaderSAV::IS_COMPRESS)
     {
         return false;
     }
 
-    auto fileDataZ = FileUtils::readFileBytes(fn);
-    ByteVectorReader fz(fileDataZ);
-
-    fz.setBigEndian(true);
-    if (fileDataZ.empty())
-        return false;
-    fileVector = FileUtils::readFileBytes(fn);
-    if (fileVector.empty())
-        return false;
-    sp<ByteVectorReader> bfz = make_shared<ByteVectorReader>(fileVector);
+    const uint32_t size = byteFs.get32();
+    const uint32_t offset = byteFs.tell();
+    if (offset + size > fileVector.size())
     {
-        bfz->setBigEndian(true);
-        bfz->seek(offset);
-        const int size = bfz->get32();
-        fileVector = bfz->getRaw(size);
-        bfz = make_shared<ByteVectorReader>(fileVector);
-        bfz->setBigEndian(true);
+        return false;
     }
+    ByteVectorReader bfz(fileVector, offset, size);
+    bfz.setBigEndian(true);
 
     if (header.status & HeaderSAV::IS_LOYALTY && !conf.PriceLoyaltyVersion())
     {
@@ -184,9 +185,7 @@ bool Game::Load(const string& fn)
                 Font::BIG, Dialog::OK);
     }
 
-    fz >> binver;
-
-    *bfz >> binver;
+    bfz >> binver;
 
     // check version: false
     if (binver > CURRENT_FORMAT_VERSION || binver < LAST_FORMAT_VERSION)
@@ -206,10 +205,19 @@ bool Game::Load(const string& fn)
     auto& gameStatic = GameStatic::Data::Get();
     auto& monsterData = MonsterStaticData::Get();
 
-    *bfz >> world >> settings >>
+    bfz >> world >> settings >>
         gameOverResult >> gameStatic
-        >> monsterData
-        >> end_check;
+        >> monsterData;
+
+    // random streams continue where the game was saved
+    if (FORMAT_VERSION_3270 <= binver)
+    {
+        vector<uint32_t> random;
+        bfz >> random;
+        Rand::SetState(random);
+    }
+
+    bfz >> end_check;
     World::PostFixLoad();
 
     if (end_check != SAV2ID2 && end_check != SAV2ID3)
@@ -227,26 +235,27 @@ bool Game::Load(const string& fn)
 
 bool Game::LoadSAV2FileInfo(const string& fn, Maps::FileInfo& finfo)
 {
-    auto fileBytes = FileUtils::readFileBytes(fn);
+    u16 binver = 0;
+    HeaderSAV header;
+
+    auto fileBytes = FileUtils::readFileBytes(fn, 0, SAV2HEADERSIZE);
     if (fileBytes.empty())
         return false;
     ByteVectorReader fs(fileBytes);
-    fs.setBigEndian(true);
-    char major, minor;
-    fs >> major >> minor;
-
-    const u16 savid = static_cast<u16>(major) << 8 | static_cast<u16>(minor);
-
-    // check version sav file
-    if (savid != SAV2ID2 && savid != SAV2ID3)
-        return false;
-
-    string strver;
-    u16 binver = 0;
-    HeaderSAV header;
 
     // read raw info
-    fs >> strver >> binver >> header;
+    if (!ReadHeaderSAV(fs, binver, header))
+    {
+        // a bad id or a short file fails for good, only a long map description
+        // reads past the prefix and needs the whole file
+        if (fs.tell() <= fs.size() || fileBytes.size() < SAV2HEADERSIZE)
+            return false;
+
+        fileBytes = FileUtils::readFileBytes(fn);
+        ByteVectorReader whole(fileBytes);
+        if (!ReadHeaderSAV(whole, binver, header))
+            return false;
+    }
 
     // hide: unsupported version
     if (binver > CURRENT_FORMAT_VERSION || binver < LAST_FORMAT_VERSION)
@@ -0,0 +1,170 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include "system.h"
+#include "tools.h"
+#include "settings.h"
+#include "world.h"
+#include "kingdom.h"
+#include "rand.h"
+#include "ai.h"
+#include "game_over.h"
+#include "profiler.h"
+#include "game_simulator.h"
+
+Game::SimulatorDay::SimulatorDay() : day(0), kingdoms(0), time(0)
+{
+}
+
+string Game::SimulatorDay::String() const
+{
+    ostringstream os;
+
+    os << "day: " << day << ", kingdoms: " << kingdoms << ", time: " << time << " ms";
+    for (const auto& turn : turns)
+        os << ", " << Color::String(turn.first) << ": " << turn.second << " ms";
+
+    return os.str();
+}
+
+bool Game::Simulator::Load(const string& file)
+{
+    Settings& conf = Settings::Get();
+    Maps::FileInfo fi;
+
+    conf.SetHeadless(true);
+    conf.ResetSound();
+    conf.ResetMusic();
+
+    if (!fi.ReadMP2(file))
+    {
+        H2ERROR("unknown map: " << file);
+        return false;
+    }
+
+    conf.SetCurrentFileInfo(fi);
+    conf.GetPlayers().SetStartGame();
+
+    for (const auto& player : conf.GetPlayers()._items)
+        if (player) player->SetControl(CONTROL_AI);
+
+    if (!world.LoadMapMP2(file))
+        return false;
+
+    AI::Init();
+    GameOver::Result::Get().Reset();
+
+    return true;
+}
+
+Game::SimulatorDay Game::Simulator::RunDay()
+{
+    Settings& conf = Settings::Get();
+    SimulatorDay res;
+    SDL::Time time;
+
+    time.Start();
+    world.NewDay();
+    Profiler::EndFrame("day " + std::to_string(world.CountDay()));
+
+    // see Interface::Basic::StartGame
+    for (const auto& player : conf.GetPlayers()._items)
+    {
+        if (!player) continue;
+
+        const int color = player->GetColor();
+        Kingdom& kingdom = world.GetKingdom(color);
+
+        if (!kingdom.isPlay()) continue;
+
+        SDL::Time turn;
+        turn.Start();
+
+        conf.SetCurrentColor(color);
+        world.ClearFog(color);
+        kingdom.ActionBeforeTurn();
+        {
+            const Rand::Stream stream(Rand::AI);
+            AI::KingdomTurn(kingdom);
+        }
+
+        turn.Stop();
+        res.turns.emplace_back(color, turn.Get());
+        Profiler::EndFrame("day " + std::to_string(world.CountDay()) + ", " + Color::String(color));
+    }
+
+    time.Stop();
+    res.day = world.CountDay();
+    res.time = time.Get();
+
+    for (const auto& player : conf.GetPlayers()._items)
+        if (player && world.GetKingdom(player->GetColor()).isPlay()) ++res.kingdoms;
+
+    return res;
+}
+
+bool Game::Simulator::isGameOver() const
+{
+    const Settings& conf = Settings::Get();
+    uint32_t count = 0;
+
+    for (const auto& player : conf.GetPlayers()._items)
+    {
+        if (!player) continue;
+
+        const Kingdom& kingdom = world.GetKingdom(player->GetColor());
+        if (!kingdom.isPlay()) continue;
+
+        if (GameOver::COND_NONE != world.CheckKingdomWins(kingdom))
+            return true;
+        ++count;
+    }
+
+    return 2 > count;
+}
+
+string Game::Simulator::State()
+{
+    const Settings& conf = Settings::Get();
+    ostringstream os;
+
+    for (const auto& player : conf.GetPlayers()._items)
+    {
+        if (!player) continue;
+
+        const Kingdom& kingdom = world.GetKingdom(player->GetColor());
+
+        os << Color::String(player->GetColor()) << ": " << (kingdom.isPlay() ? "in play" : "lost") <<
+            ", gold: " << kingdom.GetFunds().gold <<
+            ", castles: " << kingdom.GetCountCastle() <<
+            ", towns: " << kingdom.GetCountTown() <<
+            ", heroes: " << kingdom.GetHeroes()._items.size() <<
+            ", strength: " << kingdom.GetArmiesStrength();
+
+        const int wins = world.CheckKingdomWins(kingdom);
+        if (GameOver::COND_NONE != wins)
+            os << ", " << GameOver::GetString(wins);
+        os << endl;
+    }
+
+    return os.str();
+}
@@ -0,0 +1,56 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "gamedefs.h"
+
+namespace Game
+{
+    struct SimulatorDay
+    {
+        SimulatorDay();
+
+        string String() const;
+
+        uint32_t day;
+        uint32_t kingdoms; // kingdoms still in play after the day
+        uint32_t time; // ms, whole day with the new day actions
+        vector<pair<int, uint32_t>> turns; // color, AI turn ms
+    };
+
+    /* plays a map with all kingdoms under AI control, without interface, sound or sprites */
+    class Simulator
+    {
+    public:
+        // reads the MP2 or MX2 map and starts the game with every player as AI
+        bool Load(const string& file);
+
+        // new day and the turn of every kingdom in play
+        SimulatorDay RunDay();
+
+        bool isGameOver() const;
+
+        // state of the kingdoms: funds, towns, heroes and armies strength
+        static string State();
+    };
+}
@@ -32,6 +32,7 @@
 #endif
 
 #include "system.h"
+#include "profiler.h"
 #include "ai.h"
 #include "agg.h"
 #include "dialog.h"
@@ -44,6 +45,7 @@
 #include "battle_only.h"
 #include "m82.h"
 #include "settings.h"
+#include "rand.h"
 
 int Game::StartBattleOnly()
 {
@@ -556,6 +558,7 @@ int Interface::Basic::StartGame()
     while (res == Game::ENDTURN)
     {
         if (!skip_turns) world.NewDay();
+        Profiler::EndFrame("day " + std::to_string(world.CountDay()));
 
         for (const auto& it : players._items)
         {
@@ -606,11 +609,14 @@ int Interface::Basic::StartGame()
                     cursor.Show();
                     display.Flip();
 
+                    const Rand::Stream stream(Rand::AI);
                     AI::KingdomTurn(kingdom);
                 }
                 break;
             }
 
+            Profiler::EndFrame("day " + std::to_string(world.CountDay()) + ", " + Color::String(player.GetColor()));
+
             if (res != Game::ENDTURN) break;
 
             res = gameResult.LocalCheckGameOver();
@@ -768,6 +774,10 @@ int Interface::Basic::HumanTurn(bool isload)
                                                                         if (HotKeyPressEvent(Game::EVENT_SHOWICONS))
                                                                             EventSwitchShowIcons();
                                                                         else
+                                                                            // hide/show turn profiler
+                                                                            if (HotKeyPressEvent(Game::EVENT_SHOWPROFILER))
+                                                                                EventSwitchShowProfiler();
+                                                                            else
                                                                             // hero movement
                                                                             if (HotKeyPressEvent(Game::EVENT_CONTINUE))
                                                                                 EventContinueMovement();
@@ -20,6 +20,7 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <atomic>
 #include "resource.h"
 #include "mp2.h"
 #include "race.h"
@@ -190,8 +191,8 @@ namespace GameStatic
     //			        OBJ_SHIPWRECK, OBJ_MERMAID, OBJ_FAERIERING, OBJ_FOUNTAIN, OBJ_IDOL, OBJ_PYRAMID
     s8 objects_mod[] = {1, 1, 1, 2, -1, -1, -1, 1, 1, 1, 1, -2};
 
-    // world
-    uint32_t uniq = 0;
+    // world, shared with the battle estimate threads
+    atomic<uint32_t> uniq(0);
 }
 
 
@@ -230,7 +231,7 @@ ByteVectorWriter& GameStatic::operator<<(ByteVectorWriter& msg, const Data& obj)
     for (uint32_t ii = 0; ii < array_size; ++ii)
         msg << objects_mod[ii];
 
-    msg << monster_upgrade_ratio << uniq;
+    msg << monster_upgrade_ratio << uniq.load();
 
     // skill statics
     array_size = ARRAY_COUNT(Skill::_stats);
@@ -281,7 +282,9 @@ ByteVectorReader& GameStatic::operator>>(ByteVectorReader& msg, Data& obj)
     for (uint32_t ii = 0; ii < array_size; ++ii)
         msg >> objects_mod[ii];
 
-    msg >> monster_upgrade_ratio >> uniq;
+    uint32_t uniq_value = 0;
+    msg >> monster_upgrade_ratio >> uniq_value;
+    uniq = uniq_value;
 
     msg >> array_size;
     for (uint32_t ii = 0; ii < array_size; ++ii)
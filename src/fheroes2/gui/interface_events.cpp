@@ -28,6 +28,7 @@
 #include "button.h"
 #include "dialog.h"
 #include "world.h"
+#include "profiler.h"
 #include "cursor.h"
 #include "game.h"
 #include "game_interface.h"
@@ -522,6 +523,16 @@ void Interface::Basic::EventSwitchShowControlPanel() const
     gameArea.SetRedraw();
 }
 
+void Interface::Basic::EventSwitchShowProfiler()
+{
+    const bool enable = !Profiler::isEnabled();
+
+    // every turn goes to the csv file while the overlay is shown
+    Profiler::SetEnabled(enable);
+    Profiler::SetOutput(enable ? System::ConcatePath(Settings::GetSaveDir(), "profile.csv") : "");
+    SetRedraw(REDRAW_GAMEAREA);
+}
+
 void Interface::Basic::EventKeyArrowPress(int dir)
 {
     Heroes* hero = GetFocusHeroes();
@@ -572,6 +583,14 @@ void Interface::Basic::EventKeyArrowPress(int dir)
 void Interface::Basic::EventDebug1()
 {
     H2VERBOSE("");
+
+    // pathfinding benchmark: random routes for the focused hero
+    const Heroes* focus = GetFocusHeroes();
+    if (focus)
+        Route::PathfindBenchmark(*focus, 2000);
+
+    // tiles memory, world-load and scan timings
+    world.TilesBenchmark(20);
     /*
         Heroes* hero = GetFocusHeroes();
     
@@ -587,5 +606,5 @@ void Interface::Basic::EventDebug1()
 
 void Interface::Basic::EventDebug2()
 {
-    H2VERBOSE("");
+    H2VERBOSE(AGG::CacheInfo());
 }
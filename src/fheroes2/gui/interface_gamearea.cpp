@@ -26,6 +26,7 @@
 #include "ground.h"
 #include "icn.h"
 #include "game_interface.h"
+#include "profiler.h"
 #include <chrono>
 
 #define SCROLL_MIN    8
@@ -225,6 +226,7 @@ void Interface::GameArea::DrawHeroRoute(Surface& dst, int flag, const Rect& rt)
 
 void Interface::GameArea::Redraw(Surface& dst, int flag, const Rect& rt) const
 {
+    PROFILE_SCOPE("Interface::GameArea::Redraw");
     // tile
 
     for (s32 stepX = 0; stepX < rt.w; ++stepX)
@@ -558,6 +560,22 @@ void Interface::GameArea::SetScroll(int direct)
         break;
     }
 
+    // the next row or column enters the view on the coming steps
+    if (scrollDirection & direct)
+    {
+        Rect strip(rectMaps.x - 1, rectMaps.y - 1, rectMaps.w + 2, rectMaps.h + 2);
+
+        if (SCROLL_RIGHT == direct) strip.x += strip.w - 1;
+        if (SCROLL_BOTTOM == direct) strip.y += strip.h - 1;
+        if (SCROLL_LEFT == direct || SCROLL_RIGHT == direct) strip.w = 1;
+        else strip.h = 1;
+
+        for (s32 oy = strip.y; oy < strip.y + strip.h; ++oy)
+            for (s32 ox = strip.x; ox < strip.x + strip.w; ++ox)
+                if (Maps::isValidAbsPoint(ox, oy))
+                    world.GetTiles(ox, oy).PrefetchSprites();
+    }
+
     scrollTime.Start();
 }
 
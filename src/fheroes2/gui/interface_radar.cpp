@@ -20,8 +20,6 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
-#include <cmath>
-
 #include "agg.h"
 #include "settings.h"
 #include "game.h"
@@ -104,26 +102,10 @@ namespace
 
         return COLOR_GRAY;
     }
-
-    int GetChunkSize(float size1, float size2)
-    {
-        int res = 1;
-        if (size1 > size2)
-        {
-            double intpart;
-            double fractpart = modf(size1 / size2, &intpart);
-            res = static_cast<int>(intpart);
-
-            if (static_cast<int>(fractpart * 100) > 10)
-                res += 1;
-        }
-
-        return res;
-    }
 }
 
 /* constructor */
-Interface::Radar::Radar(Basic& basic) : BorderWindow(Rect(0, 0, RADARWIDTH, RADARWIDTH)), interface(basic), hide(true)
+Interface::Radar::Radar(Basic& basic) : BorderWindow(Rect(0, 0, RADARWIDTH, RADARWIDTH)), interface(basic), hide(true), fogColors(0)
 {
 }
 
@@ -150,59 +132,118 @@ void Interface::Radar::Generate()
     const Size& area = GetArea();
     const s32 world_w = world.w();
     const s32 world_h = world.h();
+    Size new_sz(area.w, area.h);
+
+    offset = Point(0, 0);
+
+    if (world_w < world_h)
+    {
+        new_sz.w = world_w * area.h / world_h;
+        offset.x = (area.w - new_sz.w) / 2;
+    }
+    else if (world_w > world_h)
+    {
+        new_sz.h = world_h * area.w / world_w;
+        offset.y = (area.h - new_sz.h) / 2;
+    }
+
+    scaleX.resize(world_w + 1);
+    scaleY.resize(world_h + 1);
+
+    for (s32 xx = 0; xx <= world_w; ++xx)
+        scaleX[xx] = xx * new_sz.w / world_w;
+
+    for (s32 yy = 0; yy <= world_h; ++yy)
+        scaleY[yy] = yy * new_sz.h / world_h;
+
+    fogColors = Players::FriendColors();
+    spriteArea.Set(new_sz.w, new_sz.h, false);
+
+    for (s32 index = 0; index < world_w * world_h; ++index)
+        RedrawTile(index);
+
+    world.vec_changes.Clear();
+}
+
+/* redraw the changed tiles only */
+void Interface::Radar::Refresh()
+{
+    if (world.vec_changes.isAll() || fogColors != Players::FriendColors() ||
+        static_cast<s32>(scaleX.size()) != world.w() + 1 || static_cast<s32>(scaleY.size()) != world.h() + 1)
+    {
+        Generate();
+        return;
+    }
+
+    world.vec_changes.Take(changes);
+
+    for (const s32 index : changes)
+        RedrawTile(index);
+}
+
+/* draw the radar pixels of one tile */
+void Interface::Radar::RedrawTile(s32 index)
+{
+    const Maps::Tiles& tile = world.GetTiles(index);
+    const s32 xx = index % world.w();
+    const s32 yy = index / world.w();
+    const Rect rt(scaleX[xx], scaleY[yy], scaleX[xx + 1] - scaleX[xx], scaleY[yy + 1] - scaleY[yy]);
+
+    // smaller than a pixel
+    if (rt.w <= 0 || rt.h <= 0)
+        return;
 
-    spriteArea.Set(world_w, world_h, false);
+    RGBA rgba(0, 0, 0);
 
-    for (s32 yy = 0; yy < world_h; ++yy)
+    if (!tile.isFog(fogColors))
     {
-        for (s32 xx = 0; xx < world_w; ++xx)
+        switch (tile.GetObject())
         {
-            const Maps::Tiles& tile = world.GetTiles(xx, yy);
-            RGBA color(0, 0, 0);
+        case MP2::OBJ_HEROES:
+            {
+                const Heroes* hero = world.GetHeroes(tile.GetCenter());
+                if (hero) rgba = AGG::GetPaletteColor(GetPaletteIndexFromColor(hero->GetColor()));
+            }
+            break;
+
+        case MP2::OBJ_CASTLE:
+        case MP2::OBJN_CASTLE:
+            {
+                const Castle* castle = world.GetCastle(tile.GetCenter());
+                if (castle) rgba = AGG::GetPaletteColor(GetPaletteIndexFromColor(castle->GetColor()));
+            }
+            break;
 
+        case MP2::OBJ_DRAGONCITY:
+            //case MP2::OBJN_DRAGONCITY:
+        case MP2::OBJ_LIGHTHOUSE:
+            //case MP2::OBJN_LIGHTHOUSE:
+        case MP2::OBJ_ALCHEMYLAB:
+            //case MP2::OBJN_ALCHEMYLAB:
+        case MP2::OBJ_MINES:
+            //case MP2::OBJN_MINES:
+        case MP2::OBJ_SAWMILL:
+            //case MP2::OBJN_SAWMILL:
+            rgba = AGG::GetPaletteColor(GetPaletteIndexFromColor(tile.QuantityColor()));
+            break;
+
+        default:
             if (tile.isRoad())
-                color = AGG::GetPaletteColor(COLOR_ROAD);
+                rgba = AGG::GetPaletteColor(COLOR_ROAD);
             else
             {
-                uint32_t index = GetPaletteIndexFromGround(tile.GetGround());
+                uint32_t color = GetPaletteIndexFromGround(tile.GetGround());
 
                 if (tile.GetObject() == MP2::OBJ_MOUNTS)
-                    index += 2;
+                    color += 2;
 
-                color = AGG::GetPaletteColor(index);
+                if (color) rgba = AGG::GetPaletteColor(color);
             }
-
-            if (color.pack())
-                spriteArea.DrawPoint(Point(xx, yy), color);
+            break;
         }
     }
 
-    if (spriteArea.GetSize() != area)
-    {
-        Size new_sz;
-
-        if (world_w < world_h)
-        {
-            new_sz.w = world_w * area.h / world_h;
-            new_sz.h = area.h;
-            offset.x = (area.w - new_sz.w) / 2;
-            offset.y = 0;
-        }
-        else if (world_w > world_h)
-        {
-            new_sz.w = area.w;
-            new_sz.h = world_h * area.w / world_w;
-            offset.x = 0;
-            offset.y = (area.h - new_sz.h) / 2;
-        }
-        else
-        {
-            new_sz.w = area.w;
-            new_sz.h = area.h;
-        }
-
-        spriteArea = spriteArea.RenderScale(new_sz);
-    }
+    spriteArea.FillRect(rt, rgba);
 }
 
 void Interface::Radar::SetHide(bool f)
@@ -237,97 +278,13 @@ void Interface::Radar::Redraw()
         {
             if (world.w() != world.h()) display.FillRect(area, ColorBlack);
             cursorArea.Hide();
+            Refresh();
             spriteArea.Blit(area.x + offset.x, area.y + offset.y, display);
-            RedrawObjects(Players::FriendColors());
             RedrawCursor();
         }
     }
 }
 
-/* redraw radar area for color */
-void Interface::Radar::RedrawObjects(int color) const
-{
-    Display& display = Display::Get();
-    const Rect& area = GetArea();
-    const s32 world_w = world.w();
-    const s32 world_h = world.h();
-    const int areaw = offset.x ? area.w - 2 * offset.x : area.w;
-    const int areah = offset.y ? area.h - 2 * offset.y : area.h;
-
-    int stepx = world_w / area.w;
-    int stepy = world_h / area.h;
-
-    if (0 == stepx) stepx = 1;
-    if (0 == stepy) stepy = 1;
-
-    int sw = 0;
-
-    if (world_w >= world_h)
-        sw = GetChunkSize(areaw, world_w);
-    else
-        sw = GetChunkSize(areah, world_h);
-
-    Surface sf(Size(sw, sw), false);
-
-    for (s32 yy = 0; yy < world_h; yy += stepy)
-    {
-        for (s32 xx = 0; xx < world_w; xx += stepx)
-        {
-            const Maps::Tiles& tile = world.GetTiles(xx, yy);
-            const bool& show_tile = !tile.isFog(color);
-            RGBA rgba(0, 0, 0);
-
-            if (show_tile)
-            {
-                switch (tile.GetObject())
-                {
-                case MP2::OBJ_HEROES:
-                    {
-                        const Heroes* hero = world.GetHeroes(tile.GetCenter());
-                        if (hero) rgba = AGG::GetPaletteColor(GetPaletteIndexFromColor(hero->GetColor()));
-                    }
-                    break;
-
-                case MP2::OBJ_CASTLE:
-                case MP2::OBJN_CASTLE:
-                    {
-                        const Castle* castle = world.GetCastle(tile.GetCenter());
-                        if (castle) rgba = AGG::GetPaletteColor(GetPaletteIndexFromColor(castle->GetColor()));
-                    }
-                    break;
-
-                case MP2::OBJ_DRAGONCITY:
-                    //case MP2::OBJN_DRAGONCITY:
-                case MP2::OBJ_LIGHTHOUSE:
-                    //case MP2::OBJN_LIGHTHOUSE:
-                case MP2::OBJ_ALCHEMYLAB:
-                    //case MP2::OBJN_ALCHEMYLAB:
-                case MP2::OBJ_MINES:
-                    //case MP2::OBJN_MINES:
-                case MP2::OBJ_SAWMILL:
-                    //case MP2::OBJN_SAWMILL:
-                    rgba = AGG::GetPaletteColor(GetPaletteIndexFromColor(tile.QuantityColor()));
-                    break;
-
-                default:
-                    continue;
-                }
-            }
-
-            const int dstx = area.x + offset.x + xx * areaw / world_w;
-            const int dsty = area.y + offset.y + yy * areah / world_h;
-
-            if (sw > 1)
-            {
-                sf.Fill(rgba);
-                sf.Blit(dstx, dsty, display);
-            }
-            else if (dstx < display.w() && dsty < display.h())
-                display.DrawPoint(Point(dstx, dsty), rgba);
-        }
-    }
-}
-
 /* redraw radar cursor */
 void Interface::Radar::RedrawCursor()
 {
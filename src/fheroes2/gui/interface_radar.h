@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <vector>
 #include "interface_border.h"
 
 namespace Interface
@@ -52,7 +53,9 @@ namespace Interface
 
         void Generate();
 
-        void RedrawObjects(int color = 0xFF) const;
+        void Refresh();
+
+        void RedrawTile(s32 index);
 
         void RedrawCursor();
 
@@ -64,5 +67,11 @@ namespace Interface
         SpriteMove cursorArea;
         Point offset;
         bool hide;
+
+        // first pixel of every world column and row in spriteArea, last entry is the size
+        std::vector<s32> scaleX;
+        std::vector<s32> scaleY;
+        std::vector<s32> changes;
+        int fogColors;
     };
 }
@@ -1480,6 +1480,10 @@ int Heroes::GetMapsObject() const
 void Heroes::SetMapsObject(int obj)
 {
     save_maps_object = obj != MP2::OBJ_HEROES ? obj : MP2::OBJ_ZERO;
+
+    // object under hero is part of the tile passable
+    if (Maps::isValidAbsIndex(GetIndex()))
+        world.GetTiles(GetIndex()).UpdateVersion();
 }
 
 bool Heroes::AllowBattle(bool attacker) const
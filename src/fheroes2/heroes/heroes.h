@@ -42,6 +42,8 @@ class MageGuild;
 namespace Battle
 {
     class Only;
+
+    class Simulator;
 }
 
 class Heroes : public HeroBase, public ColorBase
@@ -388,6 +390,8 @@ private:
 
     friend class Battle::Only;
 
+    friend class Battle::Simulator;
+
     void LevelUp(bool skipsecondary, bool autoselect = false);
 
     int LevelUpPrimarySkill();
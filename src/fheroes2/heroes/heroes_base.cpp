@@ -160,6 +160,20 @@ HeroBase::HeroBase(int type, int race)
     LoadDefaults(type, race);
 }
 
+void HeroBase::CopyBattleState(const HeroBase& from)
+{
+    attack = from.attack;
+    defense = from.defense;
+    power = from.power;
+    knowledge = from.knowledge;
+    magic_point = from.magic_point;
+    move_point = from.move_point;
+    spell_book = from.spell_book;
+    bag_artifacts = from.bag_artifacts;
+    modes = from.modes;
+    SetCenter(from.GetCenter());
+}
+
 void HeroBase::LoadDefaults(int type, int race)
 {
     if (Race::ALL & race)
@@ -154,6 +154,9 @@ public:
 
     void LoadDefaults(int type, int race);
 
+    // skills, spell points, spell book, artifacts and modes of the other commander
+    void CopyBattleState(const HeroBase&);
+
     void ReadFrom(ByteVectorReader& msg);
 
 protected:
@@ -135,6 +135,34 @@ namespace Route
         bool hide;
     };
 
+    /* move costs from the hero position to every reachable tile, single pass:
+       tiles are expanded as route points, action objects and guarded tiles only as destination */
+    class ReachMap
+    {
+    public:
+        ReachMap();
+
+        void Calculate(const Heroes&);
+
+        bool isReachable(s32) const;
+
+        uint32_t GetCost(s32) const;
+
+    private:
+        void Flood(const Heroes&);
+
+        vector<uint32_t> costs; // as destination
+        vector<uint32_t> routes; // as route point
+        vector<s32> nearby; // monsters attacked from the start: no route, like in Path::Calculate
+        s32 from;
+    };
+
+    /* hit and miss counters of the path and reach map cache */
+    string PathCacheStats();
+
+    /* times count routes from hero to random tiles, result in verbose log */
+    void PathfindBenchmark(const Heroes&, uint32_t count);
+
     ByteVectorWriter& operator<<(ByteVectorWriter&, const Step&);
     ByteVectorWriter& operator<<(ByteVectorWriter&, const Path&);
 
@@ -20,11 +20,21 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <tuple>
+
 #include "maps.h"
 #include "ai.h"
 #include "world.h"
 #include "settings.h"
 #include "ground.h"
+#include "rand.h"
+#include "thread.h"
+#include "profiler.h"
+#include "system.h"
 
 struct cell_t
 {
@@ -41,53 +51,45 @@ struct cell_t
     s32 parent;
 };
 
-int GetCurrentLength(map<s32, cell_t>& list, s32 from)
-{
-    int res = 0;
-    while (0 <= list[from].parent)
-    {
-        from = list[from].parent;
-        ++res;
-    }
-    return res;
-}
-
 bool CheckMonsterProtectionAndNotDst(const s32& to, const s32& dst)
 {
     const MapsIndexes& monsters = Maps::GetTilesUnderProtection(to);
     return !monsters.empty() && monsters.end() == find(monsters.begin(), monsters.end(), dst);
 }
 
-bool PassableToTile(const Heroes& hero, const Maps::Tiles& toTile, int direct, s32 dst)
+bool PassableToTile(const Heroes& hero, s32 to, int direct, s32 dst)
 {
+    const Maps::TilePassable& toTile = world.vec_passable.Get(to);
+    const bool ship = hero.isShipMaster();
+    const bool skipfog = hero.isControlAI() ? AI::HeroesSkipFog() : false;
+    const int color = Settings::Get().CurrentColor();
+
     // check end point
-    if (toTile.GetIndex() == dst)
+    if (to == dst)
     {
         // fix toTilePassable with action object
-        if (MP2::isPickupObject(toTile.GetObject()))
+        if (toTile.flags & Maps::PASS_PICKUP)
             return true;
 
         // check direct to object
-        if (MP2::isActionObject(toTile.GetObject(false), hero.isShipMaster()))
-            return Direction::Reflect(direct) & toTile.GetPassable();
+        if (toTile.isAction(true, ship))
+            return Direction::Reflect(direct) & toTile.direct;
 
-        if (MP2::OBJ_HEROES == toTile.GetObject())
-            return toTile.isPassable(nullptr, Direction::Reflect(direct),
-                                     hero.isControlAI() ? AI::HeroesSkipFog() : false);
+        if (MP2::OBJ_HEROES == toTile.object)
+            return toTile.isPassable(false, ship, Direction::Reflect(direct), skipfog, color);
     }
 
     // check to tile direct
-    if (!toTile.isPassable(&hero, Direction::Reflect(direct), hero.isControlAI() ? AI::HeroesSkipFog() : false))
+    if (!toTile.isPassable(true, ship, Direction::Reflect(direct), skipfog, color))
         return false;
 
-    if (toTile.GetIndex() != dst)
+    if (to != dst)
     {
-        if (MP2::isPickupObject(toTile.GetObject()) ||
-            MP2::isActionObject(toTile.GetObject(false), hero.isShipMaster()))
+        if (toTile.flags & Maps::PASS_PICKUP || toTile.isAction(true, ship))
             return false;
 
         // check hero/monster on route
-        switch (toTile.GetObject())
+        switch (toTile.object)
         {
         case MP2::OBJ_HEROES:
         case MP2::OBJ_MONSTER:
@@ -98,7 +100,7 @@ bool PassableToTile(const Heroes& hero, const Maps::Tiles& toTile, int direct, s
         }
 
         // check monster protection
-        if (CheckMonsterProtectionAndNotDst(toTile.GetIndex(), dst))
+        if (toTile.flags & Maps::PASS_GUARDED && CheckMonsterProtectionAndNotDst(to, dst))
             return false;
     }
 
@@ -107,44 +109,32 @@ bool PassableToTile(const Heroes& hero, const Maps::Tiles& toTile, int direct, s
 
 bool PassableFromToTile(const Heroes& hero, s32 from, const s32& to, int direct, s32 dst)
 {
-    const Maps::Tiles& fromTile = world.GetTiles(from);
-    const Maps::Tiles& toTile = world.GetTiles(to);
+    const Maps::PassableLayer& layer = world.vec_passable;
+    const Maps::TilePassable& fromTile = layer.Get(from);
+    const Maps::TilePassable& toTile = layer.Get(to);
+    const bool ship = hero.isShipMaster();
 
-    // check start point
-    if (hero.GetIndex() == from)
+    // check start point: hero stands over the object
+    if (fromTile.isAction(hero.GetIndex() == from, ship))
     {
-        if (MP2::isActionObject(fromTile.GetObject(false), hero.isShipMaster()))
-        {
-            // check direct from object
-            if (!(direct & fromTile.GetPassable()))
-                return false;
-        }
-        else
-        {
-            // check from tile direct
-            if (!fromTile.isPassable(&hero, direct, hero.isControlAI() ? AI::HeroesSkipFog() : false))
-                return false;
-        }
+        // check direct from object
+        if (!(direct & fromTile.direct))
+            return false;
     }
     else
     {
-        if (MP2::isActionObject(fromTile.GetObject(), hero.isShipMaster()))
-        {
-            // check direct from object
-            if (!(direct & fromTile.GetPassable()))
-                return false;
-        }
-        else
-        {
-            // check from tile direct
-            if (!fromTile.isPassable(&hero, direct, hero.isControlAI() ? AI::HeroesSkipFog() : false))
-                return false;
-        }
+        // check from tile direct
+        if (!fromTile.isPassable(true, ship, direct, hero.isControlAI() ? AI::HeroesSkipFog() : false,
+                                 Settings::Get().CurrentColor()))
+            return false;
     }
 
-    if (fromTile.isWater() && !toTile.isWater())
+    const bool fromWater = 0 != (fromTile.flags & Maps::PASS_WATER);
+    const bool toWater = 0 != (toTile.flags & Maps::PASS_WATER);
+
+    if (fromWater && !toWater)
     {
-        switch (toTile.GetObject())
+        switch (toTile.object)
         {
         case MP2::OBJ_BOAT:
         case MP2::OBJ_MONSTER:
@@ -152,21 +142,21 @@ bool PassableFromToTile(const Heroes& hero, s32 from, const s32& to, int direct,
             return false;
 
         case MP2::OBJ_COAST:
-            return toTile.GetIndex() == dst;
+            return to == dst;
 
         default:
             break;
         }
     }
-    else if (!fromTile.isWater() && toTile.isWater())
+    else if (!fromWater && toWater)
     {
-        switch (toTile.GetObject())
+        switch (toTile.object)
         {
         case MP2::OBJ_BOAT:
             return true;
 
         case MP2::OBJ_HEROES:
-            return toTile.GetIndex() == dst;
+            return to == dst;
 
         default:
             break;
@@ -174,41 +164,35 @@ bool PassableFromToTile(const Heroes& hero, s32 from, const s32& to, int direct,
     }
 
     // check corner water/coast
-    if (hero.isShipMaster() &&
+    if (ship &&
         direct & (Direction::TOP_LEFT | Direction::TOP_RIGHT | Direction::BOTTOM_RIGHT | Direction::BOTTOM_LEFT))
     {
         const Size wSize(world.w(), world.h());
+        auto isGround = [&](int side)
+        {
+            return Maps::isValidDirection(from, side, wSize) &&
+                !(layer.Get(Maps::GetDirectionIndex(from, side)).flags & Maps::PASS_WATER);
+        };
+
         switch (direct)
         {
         case Direction::TOP_LEFT:
-            if ((Maps::isValidDirection(from, Direction::TOP, wSize) &&
-                !world.GetTiles(Maps::GetDirectionIndex(from, Direction::TOP)).isWater()) ||
-                (Maps::isValidDirection(from, Direction::LEFT, wSize) &&
-                !world.GetTiles(Maps::GetDirectionIndex(from, Direction::LEFT)).isWater()))
+            if (isGround(Direction::TOP) || isGround(Direction::LEFT))
                 return false;
             break;
 
         case Direction::TOP_RIGHT:
-            if ((Maps::isValidDirection(from, Direction::TOP, wSize) &&
-                !world.GetTiles(Maps::GetDirectionIndex(from, Direction::TOP)).isWater()) ||
-                (Maps::isValidDirection(from, Direction::RIGHT, wSize) &&
-                !world.GetTiles(Maps::GetDirectionIndex(from, Direction::RIGHT)).isWater()))
+            if (isGround(Direction::TOP) || isGround(Direction::RIGHT))
                 return false;
             break;
 
         case Direction::BOTTOM_RIGHT:
-            if ((Maps::isValidDirection(from, Direction::BOTTOM, wSize) &&
-                !world.GetTiles(Maps::GetDirectionIndex(from, Direction::BOTTOM)).isWater()) ||
-                (Maps::isValidDirection(from, Direction::RIGHT, wSize) &&
-                !world.GetTiles(Maps::GetDirectionIndex(from, Direction::RIGHT)).isWater()))
+            if (isGround(Direction::BOTTOM) || isGround(Direction::RIGHT))
                 return false;
             break;
 
         case Direction::BOTTOM_LEFT:
-            if ((Maps::isValidDirection(from, Direction::BOTTOM, wSize) &&
-                !world.GetTiles(Maps::GetDirectionIndex(from, Direction::BOTTOM)).isWater()) ||
-                (Maps::isValidDirection(from, Direction::LEFT, wSize) &&
-                !world.GetTiles(Maps::GetDirectionIndex(from, Direction::LEFT)).isWater()))
+            if (isGround(Direction::BOTTOM) || isGround(Direction::LEFT))
                 return false;
             break;
 
@@ -217,7 +201,7 @@ bool PassableFromToTile(const Heroes& hero, s32 from, const s32& to, int direct,
         }
     }
 
-    return PassableToTile(hero, toTile, direct, dst);
+    return PassableToTile(hero, to, direct, dst);
 }
 
 uint32_t GetPenaltyFromTo(s32 from, s32 to, int direct, int pathfinding)
@@ -230,103 +214,184 @@ uint32_t GetPenaltyFromTo(s32 from, s32 to, int direct, int pathfinding)
 
 namespace
 {
-    struct RowInMap
+    struct OpenNode
     {
-        int Key{};
-        cell_t Value;
-        int Hash{};
-        int PrevIndex{};
+        uint32_t cost;
+        uint32_t order;
+        s32 index;
+
+        bool operator>(const OpenNode& other) const
+        {
+            return cost != other.cost ? cost > other.cost : order > other.order;
+        }
     };
 
-    struct PathMap
+    /* flat scratch state for one world, reused between searches:
+       a cell belongs to the current search only if its stamp equals the generation */
+    struct PathScratch
     {
-        std::vector<s32> _jumpTable;
-        std::vector<RowInMap> _rows;
-        int _sizePow2;
-        int mask{};
-
-        void clear()
+        std::vector<cell_t> cells;
+        std::vector<uint32_t> stamps;
+        std::vector<uint32_t> orders;
+        std::vector<OpenNode> heap;
+        uint32_t generation = 0;
+        uint32_t counter = 0;
+
+        void reset(size_t size)
         {
-            mask = (1 << _sizePow2) - 1;
-            _jumpTable.clear();
-            _jumpTable.reserve(mask + 1);
-            for (int i = 0; i <= mask; i++)
-                _jumpTable[i] = -1;
-            _rows.clear();
+            if (cells.size() != size)
+            {
+                cells.assign(size, cell_t());
+                stamps.assign(size, 0);
+                orders.assign(size, 0);
+                generation = 0;
+            }
+
+            ++generation;
+            if (0 == generation)
+            {
+                std::fill(stamps.begin(), stamps.end(), 0);
+                generation = 1;
+            }
+
+            counter = 0;
+            heap.clear();
         }
 
-        PathMap(int sizePow2 = 10)
+        cell_t& get(s32 index)
         {
-            _sizePow2 = sizePow2;
-            clear();
+            if (stamps[index] != generation)
+            {
+                stamps[index] = generation;
+                cells[index] = cell_t();
+                // first touch order keeps the old "first row with minimal cost" tie break
+                orders[index] = counter++;
+            }
+            return cells[index];
         }
 
-        static int hashInt(int key)
+        void push(s32 index)
         {
-            return (key >> 4) * 31 + (key >> 3) * 7 + (key >> 5) * 7 + (key >> 6) * 13;
+            const cell_t& cell = cells[index];
+            heap.push_back({static_cast<uint32_t>(cell.cost_t + cell.cost_d), orders[index], index});
+            std::push_heap(heap.begin(), heap.end(), std::greater<OpenNode>());
         }
 
-        cell_t& get(int key)
+        // lowest open cell, -1 if nothing left below MAXU16
+        s32 pop()
         {
-            const int hash = hashInt(key);
-            const int maskedHash = hash & mask;
-            RowInMap row;
-            row.Key = key;
-            row.Hash = hash;
-            int indexToSearch = _jumpTable[maskedHash];
-            if (indexToSearch == -1)
+            while (!heap.empty())
             {
-                row.PrevIndex = -1;
+                const OpenNode node = heap.front();
+                std::pop_heap(heap.begin(), heap.end(), std::greater<OpenNode>());
+                heap.pop_back();
+
+                if (MAXU16 <= node.cost) return -1;
+
+                const cell_t& cell = cells[node.index];
+                // skip closed cells and entries outdated by a cheaper parent
+                if (cell.open && node.cost == static_cast<uint32_t>(cell.cost_t + cell.cost_d))
+                    return node.index;
             }
-            else
+            return -1;
+        }
+
+        int length(s32 from) const
+        {
+            int res = 0;
+            while (0 <= cells[from].parent)
             {
-                do
-                {
-                    auto& rowRef = _rows[indexToSearch];
-                    if (rowRef.Key == key)
-                    {
-                        return rowRef.Value;
-                    }
-                    indexToSearch = rowRef.PrevIndex;
-                }
-                while (indexToSearch != -1);
-                row.PrevIndex = _jumpTable[maskedHash];
+                from = cells[from].parent;
+                ++res;
             }
-
-            _jumpTable[maskedHash] = _rows.size();
-            _rows.push_back(row);
-            return _rows.back().Value;
+            return res;
         }
     };
 
-    PathMap pathPointsMap2;
+    PathScratch pathScratch;
 
-    int GetCurrentLength(PathMap& list, s32 from)
+    /* hero state the search depends on, besides the map */
+    struct PathKey
     {
-        int res = 0;
-        while (0 <= list.get(from).parent)
+        int hero;
+        s32 from;
+        int pathfinding;
+        int modes;
+        s32 to;
+        int limit;
+
+        PathKey(const Heroes& h, s32 dst, int lim) : hero(h.GetID()), from(h.GetIndex()),
+                                                     pathfinding(h.GetLevelSkill(Skill::SkillT::PATHFINDING)),
+                                                     modes((h.isShipMaster() ? 1 : 0) | (h.isControlAI() ? 2 : 0)),
+                                                     to(dst), limit(lim)
         {
-            from = list.get(from).parent;
-            ++res;
+            // fog checks are made for the current player
+            modes |= Settings::Get().CurrentColor() << 2;
         }
-        return res;
-    }
+
+        bool operator<(const PathKey& other) const
+        {
+            return std::tie(hero, from, pathfinding, modes, to, limit) <
+                std::tie(other.hero, other.from, other.pathfinding, other.modes, other.to, other.limit);
+        }
+    };
+
+    /* routes and reach maps, valid until any tile changes */
+    struct PathCache
+    {
+        enum
+        {
+            MAX_PATHS = 4096,
+            MAX_REACHES = 16
+        };
+
+        uint32_t version = MAXU32;
+        std::map<PathKey, std::vector<Route::Step>> paths;
+        std::map<PathKey, Route::ReachMap> reaches;
+
+        uint32_t pathHits = 0;
+        uint32_t pathMisses = 0;
+        uint32_t reachHits = 0;
+        uint32_t reachMisses = 0;
+
+        void Validate()
+        {
+            if (version == Maps::Tiles::GetVersion())
+                return;
+            version = Maps::Tiles::GetVersion();
+            paths.clear();
+            reaches.clear();
+        }
+    };
+
+    PathCache pathCache;
 }
 
 bool Route::Path::Find(s32 to, int limit)
 {
+    PROFILE_SCOPE("Route::Path::Find");
+    pathCache.Validate();
+
+    const PathKey key(*hero, to, limit);
+    auto cached = pathCache.paths.find(key);
+    if (cached != pathCache.paths.end())
+    {
+        ++pathCache.pathHits;
+        assign(cached->second.begin(), cached->second.end());
+        return !empty();
+    }
+    ++pathCache.pathMisses;
+    world.vec_passable.Refresh();
+
     const int pathfinding = hero->GetLevelSkill(Skill::SkillT::PATHFINDING);
     const s32 from = hero->GetIndex();
 
     s32 cur = from;
-    s32 alt = 0;
     s32 tmp = 0;
 
-    pathPointsMap2.clear();
-    auto it1_2 = pathPointsMap2._rows.begin();
-    auto it2_2 = pathPointsMap2._rows.end();
+    pathScratch.reset(world.w() * world.h());
 
-    cell_t& currCell = pathPointsMap2.get(cur);
+    cell_t& currCell = pathScratch.get(cur);
     currCell.cost_g = 0;
     currCell.cost_t = 0;
     currCell.parent = -1;
@@ -336,88 +401,69 @@ bool Route::Path::Find(s32 to, int limit)
     clear();
 
     const Size wSize(world.w(), world.h());
-    LocalEvent::Get().HandleEvents(false);
+    if (!Settings::Get().Headless())
+        LocalEvent::Get().HandleEvents(false);
     while (cur != to)
     {
+        cell_t& curItem = pathScratch.get(cur);
+
         for (auto& direction : directions)
         {
             if (!Maps::isValidDirection(cur, direction, wSize))
                 continue;
             tmp = Maps::GetDirectionIndex(cur, direction);
-            auto& tmpItem2 = pathPointsMap2.get(tmp);
-            auto& curItem2 = pathPointsMap2.get(cur);
+            cell_t& tmpItem = pathScratch.get(tmp);
 
-            if (!tmpItem2.open) continue;
+            if (!tmpItem.open) continue;
             const uint32_t costg = GetPenaltyFromTo(cur, tmp, direction, pathfinding);
 
             // new
-            if (-1 == tmpItem2.parent)
+            if (-1 == tmpItem.parent)
             {
-                if (curItem2.passbl & direction ||
+                if (curItem.passbl & direction ||
                     PassableFromToTile(*hero, cur, tmp, direction, to))
                 {
-                    curItem2.passbl |= direction;
-
-                    tmpItem2.direct = direction;
-                    tmpItem2.cost_g = costg;
-                    tmpItem2.parent = cur;
-                    tmpItem2.open = 1;
-                    tmpItem2.cost_d = 50 * Maps::GetApproximateDistance(tmp, to);
-                    tmpItem2.cost_t = curItem2.cost_t + costg;
-
-                    curItem2.passbl |= direction;
-
-                    tmpItem2.direct = direction;
-                    tmpItem2.cost_g = costg;
-                    tmpItem2.parent = cur;
-                    tmpItem2.open = 1;
-                    tmpItem2.cost_d = 50 * Maps::GetApproximateDistance(tmp, to);
-                    tmpItem2.cost_t = curItem2.cost_t + costg;
+                    curItem.passbl |= direction;
+
+                    tmpItem.direct = direction;
+                    tmpItem.cost_g = costg;
+                    tmpItem.parent = cur;
+                    tmpItem.open = 1;
+                    tmpItem.cost_d = 50 * Maps::GetApproximateDistance(tmp, to);
+                    tmpItem.cost_t = curItem.cost_t + costg;
+
+                    pathScratch.push(tmp);
                 }
             }
                 // check alt
             else
             {
-                if (tmpItem2.cost_t > curItem2.cost_t + costg &&
-                    (curItem2.passbl & direction || PassableFromToTile(*hero, cur, tmp, direction, to)))
+                if (tmpItem.cost_t > curItem.cost_t + costg &&
+                    (curItem.passbl & direction || PassableFromToTile(*hero, cur, tmp, direction, to)))
                 {
-                    curItem2.passbl |= direction;
+                    curItem.passbl |= direction;
+
+                    tmpItem.direct = direction;
+                    tmpItem.parent = cur;
+                    tmpItem.cost_g = costg;
+                    tmpItem.cost_t = curItem.cost_t + costg;
 
-                    tmpItem2.direct = direction;
-                    tmpItem2.parent = cur;
-                    tmpItem2.cost_g = costg;
-                    tmpItem2.cost_t = curItem2.cost_t + costg;
+                    pathScratch.push(tmp);
                 }
             }
         }
 
-
-        pathPointsMap2.get(cur).open = 0;
-
-        it1_2 = pathPointsMap2._rows.begin();
-        alt = -1;
-        tmp = MAXU16;
+        curItem.open = 0;
 
         // find minimal cost
-        it2_2 = pathPointsMap2._rows.end();
-        for (; it1_2 != it2_2; ++it1_2)
-            if ((*it1_2).Value.open)
-            {
-                const cell_t& cell2 = (*it1_2).Value;
+        const s32 alt = pathScratch.pop();
 
-                if (cell2.cost_t + cell2.cost_d < tmp)
-                {
-                    tmp = cell2.cost_t + cell2.cost_d;
-                    alt = (*it1_2).Key;
-                }
-            }
         // not found, and exception
-        if (MAXU16 == tmp || -1 == alt) break;
+        if (-1 == alt) break;
 
         cur = alt;
 
-        //if (0 < limit && GetCurrentLength(pathPointsMap, cur) > limit) break;
-        if (0 < limit && GetCurrentLength(pathPointsMap2, cur) > limit) break;
+        if (0 < limit && pathScratch.length(cur) > limit) break;
     }
 
     // save path
@@ -425,10 +471,173 @@ bool Route::Path::Find(s32 to, int limit)
     {
         while (cur != from)
         {
-            auto& curItem2 = pathPointsMap2.get(cur);
-            push_front(Step(curItem2.parent, curItem2.direct, curItem2.cost_g));
-            cur = curItem2.parent;
+            const cell_t& curItem = pathScratch.get(cur);
+            push_front(Step(curItem.parent, curItem.direct, curItem.cost_g));
+            cur = curItem.parent;
         }
     }
+
+    if (pathCache.paths.size() >= PathCache::MAX_PATHS)
+        pathCache.paths.clear();
+    pathCache.paths[key].assign(begin(), end());
+
     return !empty();
 }
+
+Route::ReachMap::ReachMap() : from(-1)
+{
+}
+
+void Route::ReachMap::Calculate(const Heroes& hero)
+{
+    pathCache.Validate();
+
+    const PathKey key(hero, -1, -1);
+    auto cached = pathCache.reaches.find(key);
+    if (cached != pathCache.reaches.end())
+    {
+        ++pathCache.reachHits;
+        *this = cached->second;
+        return;
+    }
+    ++pathCache.reachMisses;
+
+    Flood(hero);
+
+    if (pathCache.reaches.size() >= PathCache::MAX_REACHES)
+        pathCache.reaches.clear();
+    pathCache.reaches[key] = *this;
+}
+
+void Route::ReachMap::Flood(const Heroes& hero)
+{
+    from = hero.GetIndex();
+    costs.assign(world.w() * world.h(), MAXU32);
+    routes.assign(costs.size(), MAXU32);
+    nearby.clear();
+
+    if (!Maps::isValidAbsIndex(from)) return;
+
+    world.vec_passable.Refresh();
+
+    const int pathfinding = hero.GetLevelSkill(Skill::SkillT::PATHFINDING);
+    const Directions directions = Direction::All();
+    const Size wSize(world.w(), world.h());
+
+    std::vector<OpenNode> heap;
+    costs[from] = 0;
+    routes[from] = 0;
+    heap.push_back({0, 0, from});
+
+    while (!heap.empty())
+    {
+        const OpenNode node = heap.front();
+        std::pop_heap(heap.begin(), heap.end(), std::greater<OpenNode>());
+        heap.pop_back();
+
+        const s32 cur = node.index;
+        if (node.cost != routes[cur]) continue;
+
+        for (auto& direction : directions)
+        {
+            if (!Maps::isValidDirection(cur, direction, wSize))
+                continue;
+            const s32 tmp = Maps::GetDirectionIndex(cur, direction);
+            const uint32_t cost = node.cost + GetPenaltyFromTo(cur, tmp, direction, pathfinding);
+
+            if (cost >= costs[tmp] && cost >= routes[tmp])
+                continue;
+
+            if (cost < routes[tmp] && PassableFromToTile(hero, cur, tmp, direction, -1))
+            {
+                routes[tmp] = cost;
+                if (cost < costs[tmp]) costs[tmp] = cost;
+                heap.push_back({cost, 0, tmp});
+                std::push_heap(heap.begin(), heap.end(), std::greater<OpenNode>());
+            }
+            else if (cost < costs[tmp])
+            {
+                // action object, hero or guarded tile: reachable as destination only
+                if (PassableFromToTile(hero, cur, tmp, direction, tmp))
+                {
+                    costs[tmp] = cost;
+
+                    // the route is the attack step only, Path::Calculate drops it
+                    if (cur == from && MP2::OBJ_MONSTER == world.GetTiles(tmp).GetObject())
+                        nearby.push_back(tmp);
+                }
+
+                // guarded tile is a route point when attacking its guard
+                if (!(world.vec_passable.Get(tmp).flags & Maps::PASS_GUARDED))
+                    continue;
+
+                for (const s32 monster : Maps::GetTilesUnderProtection(tmp))
+                {
+                    if (monster == tmp) continue;
+
+                    const int direct = Direction::Get(tmp, monster);
+                    const uint32_t attack = cost + GetPenaltyFromTo(tmp, monster, direct, pathfinding);
+
+                    if (attack < costs[monster] &&
+                        PassableFromToTile(hero, cur, tmp, direction, monster) &&
+                        PassableFromToTile(hero, tmp, monster, direct, monster))
+                    {
+                        costs[monster] = attack;
+                        nearby.erase(std::remove(nearby.begin(), nearby.end(), monster), nearby.end());
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool Route::ReachMap::isReachable(s32 index) const
+{
+    return index != from && GetCost(index) != MAXU32 &&
+        nearby.end() == std::find(nearby.begin(), nearby.end(), index);
+}
+
+uint32_t Route::ReachMap::GetCost(s32 index) const
+{
+    return 0 <= index && index < static_cast<s32>(costs.size()) ? costs[index] : MAXU32;
+}
+
+string Route::PathCacheStats()
+{
+    ostringstream os;
+    os << "paths: hits " << pathCache.pathHits << ", misses " << pathCache.pathMisses <<
+        ", reach maps: hits " << pathCache.reachHits << ", misses " << pathCache.reachMisses;
+    return os.str();
+}
+
+void Route::PathfindBenchmark(const Heroes& hero, uint32_t count)
+{
+    const s32 size = world.w() * world.h();
+    if (!size) return;
+
+    // own fixed seed and an empty cache: the world stream saved with the game and the live cache stay as they are
+    Rand::Generator generator(1);
+    PathCache live;
+    std::swap(live, pathCache);
+
+    Path path(hero);
+    uint32_t found = 0;
+    uint32_t steps = 0;
+
+    SDL::Time time;
+    time.Start();
+    for (uint32_t ii = 0; ii < count; ++ii)
+    {
+        if (path.Calculate(generator.Next() % size))
+        {
+            ++found;
+            steps += path.size();
+        }
+    }
+    time.Stop();
+
+    std::swap(live, pathCache);
+
+    H2VERBOSE("routes: " << count << ", found: " << found << ", steps: " << steps <<
+        ", time: " << time.Get() << " ms");
+}
@@ -227,7 +227,7 @@ void Kingdom::AddHeroes(Heroes* hero)
         heroes._items.push_back(hero);
 
     auto player = Settings::Get().GetPlayers().GetCurrent();
-    if (player && player->isColor(GetColor()))
+    if (player && player->isColor(GetColor()) && !Settings::Get().Headless())
         Interface::Basic::Get().GetIconsPanel().ResetIcons(icons_t::ICON_HEROES);
 
     AI::HeroesAdd(*hero);
@@ -279,7 +279,7 @@ void Kingdom::AddCastle(const Castle* castle)
             castles._items.push_back(const_cast<Castle *>(castle));
 
         auto player = Settings::Get().GetPlayers().GetCurrent();
-        if (player && player->isColor(GetColor()))
+        if (player && player->isColor(GetColor()) && !Settings::Get().Headless())
             Interface::Basic::Get().GetIconsPanel().ResetIcons(icons_t::ICON_CASTLES);
 
         AI::CastleAdd(*castle);
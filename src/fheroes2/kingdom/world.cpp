@@ -22,6 +22,7 @@
 
 #include <functional>
 #include <algorithm>
+#include <atomic>
 #include "agg.h"
 #include "artifact.h"
 #include "resource.h"
@@ -33,13 +34,16 @@
 #include "maps_actions.h"
 #include "world.h"
 #include "rand.h"
+#include "system.h"
+#include "thread.h"
+#include "profiler.h"
 #include <random>
 #include <sstream>
 #include <iostream>
 
 namespace GameStatic
 {
-    extern uint32_t uniq;
+    extern atomic<uint32_t> uniq;
 }
 
 MapObjects::~MapObjects()
@@ -257,6 +261,11 @@ void World::Reset()
 {
     // maps tiles
     vec_tiles.clear();
+    vec_hot.Clear();
+    vec_passable.Clear();
+    vec_objects.Clear();
+    vec_fog.Clear();
+    vec_changes.Reset(0);
 
     // kingdoms
     vec_kingdoms.clear();
@@ -301,6 +310,9 @@ void World::NewMaps(uint32_t sw, uint32_t sh)
     Size::h = sh;
 
     vec_tiles.resize(w() * h());
+    vec_hot.Reset(w() * h());
+    vec_fog.Reset(w(), h());
+    vec_changes.Reset(w() * h());
 
     // init all tiles
     for (auto
@@ -324,6 +336,9 @@ void World::NewMaps(uint32_t sw, uint32_t sh)
         (*it).Init(distance(vec_tiles.begin(), it), mp2tile);
     }
 
+    vec_passable.Build();
+    vec_objects.Build();
+
     // reset current maps info
     Maps::FileInfo fi;
     fi.size_w = w();
@@ -478,6 +493,7 @@ const Week& World::GetWeekType() const
 /* new day */
 void World::NewDay()
 {
+    PROFILE_SCOPE("World::NewDay");
     ++day;
 
     if (BeginWeek())
@@ -515,6 +531,7 @@ void World::NewDay()
 
 void World::NewWeek()
 {
+    PROFILE_SCOPE("World::NewWeek");
     // update week type
     week_current = week_next;
     const int type = LastWeek() ? Week::MonthRand() : Week::WeekRand();
@@ -554,6 +571,7 @@ void World::NewWeek()
 
 void World::NewMonth()
 {
+    PROFILE_SCOPE("World::NewMonth");
     // skip first month
     if (1 < week && week_current.GetType() == Week::MONSTERS && !Settings::Get().ExtWorldBanMonthOfMonsters())
         MonthOfMonstersAction(Monster(week_current.GetMonster()));
@@ -749,6 +767,7 @@ void World::CaptureObject(s32 index, int color)
 {
     int obj = GetTiles(index).GetObject(false);
     map_captureobj.Set(index, obj, color);
+    vec_changes.SetChanged(index);
 
     if (MP2::OBJ_CASTLE == obj)
     {
@@ -780,6 +799,7 @@ CapturedObject& World::GetCapturedObject(s32 index)
 void World::ResetCapturedObjects(int color)
 {
     map_captureobj.ResetColor(color);
+    vec_changes.SetAll();
 }
 
 void World::ClearFog(int colors)
@@ -1215,6 +1235,61 @@ ByteVectorReader& operator>>(ByteVectorReader& msg, MapObjects& objs)
 }
 
 
+void World::TilesBenchmark(uint32_t count)
+{
+    if (vec_tiles.empty()) return;
+
+    SDL::Time save;
+    save.Start();
+    ByteVectorWriter msg;
+    msg.SetBigEndian(true);
+    msg << vec_tiles;
+    const vector<u8> data = msg.data();
+    save.Stop();
+
+    // the world-load path: every tile and its addons from the save stream,
+    // into detached layers and arena, the live world and the tiles version stay as they are
+    const uint32_t version = Maps::Tiles::GetVersion();
+    Maps::TilesLayer hot;
+    Maps::FogLayer fog;
+    hot.Reset(vec_tiles.size());
+    fog.Reset(w(), h());
+    vec_hot.Swap(hot);
+    swap(vec_fog, fog);
+
+    SDL::Time load;
+    {
+        Maps::ScopedAddonArena arena;
+        load.Start();
+        MapsTiles tiles;
+        ByteVectorReader stream(data);
+        stream.setBigEndian(true);
+        stream >> tiles;
+        load.Stop();
+    }
+
+    vec_hot.Swap(hot);
+    swap(vec_fog, fog);
+    Maps::Tiles::RestoreVersion(version);
+
+    // object scan as the AI does it, addons included
+    SDL::Time scan;
+    uint32_t objects = 0;
+    scan.Start();
+    for (uint32_t ii = 0; ii < count; ++ii)
+        for (const Maps::Tiles& tile : vec_tiles)
+        {
+            const int obj = tile.GetObject(false);
+            if (MP2::OBJ_ZERO != obj && tile.FindObjectConst(obj)) ++objects;
+        }
+    scan.Stop();
+
+    H2VERBOSE("tiles: " << vec_tiles.size() << ", bytes: " << vec_tiles.size() * sizeof(Maps::Tiles) <<
+        ", hot bytes: " << vec_hot.Bytes() << ", " <<
+        Maps::Addons::ArenaInfo() << ", save: " << save.Get() << " ms, load: " << load.Get() << " ms, scans: " <<
+        count << ", objects: " << objects << ", time: " << scan.Get() << " ms");
+}
+
 ByteVectorWriter& operator<<(ByteVectorWriter& msg, const World& w)
 {
     const Size& sz = w;
@@ -1244,7 +1319,13 @@ ByteVectorReader& operator>>(ByteVectorReader& msg, World& w)
 {
     Size& sz = w;
 
+    w.vec_passable.Clear();
+    w.vec_objects.Clear();
     msg >> sz;
+    // tiles restore their fields and fog into them
+    w.vec_hot.Reset(w.w() * w.h());
+    w.vec_fog.Reset(w.w(), w.h());
+    w.vec_changes.Reset(w.w() * w.h());
     msg >> w.vec_tiles;
     msg >> w.vec_heroes;
     msg >> w.vec_castles;
@@ -1264,6 +1345,8 @@ ByteVectorReader& operator>>(ByteVectorReader& msg, World& w)
     // update tile passable
     for_each(w.vec_tiles.begin(), w.vec_tiles.end(),
              [](Maps::Tiles& it) { it.UpdatePassable(); });
+    w.vec_passable.Build();
+    w.vec_objects.Build();
 
     // heroes postfix
     for_each(w.vec_heroes._items.begin(), w.vec_heroes._items.end(),
@@ -28,6 +28,10 @@
 #include "gamedefs.h"
 #include "maps.h"
 #include "maps_tiles.h"
+#include "maps_tiles_layer.h"
+#include "maps_passable.h"
+#include "maps_index.h"
+#include "maps_fog.h"
 #include "week.h"
 #include "kingdom.h"
 #include "castle_heroes.h"
@@ -316,6 +320,9 @@ public:
 
     static void PostFixLoad();
 
+    /* times saving, loading and count object scans of the tiles, result in verbose log */
+    void TilesBenchmark(uint32_t count);
+
 private:
     World() : Size(0, 0), day(0), week(0), month(0), heroes_cond_wins(0), heroes_cond_loss(0)
     {
@@ -336,6 +343,11 @@ private:
     friend ByteVectorReader& operator>>(ByteVectorReader&, World&);
 public:
     MapsTiles vec_tiles;
+    Maps::TilesLayer vec_hot;
+    Maps::PassableLayer vec_passable;
+    Maps::ObjectsIndex vec_objects;
+    Maps::FogLayer vec_fog;
+    Maps::ChangedTiles vec_changes; // for the radar
     AllHeroes vec_heroes;
     AllCastles vec_castles;
     Kingdoms vec_kingdoms;
@@ -376,3 +388,79 @@ ByteVectorWriter& operator<<(ByteVectorWriter& msg, const MapObjects& objs);
 ByteVectorReader& operator>>(ByteVectorReader&, MapObjects&);
 
 extern World& world;
+
+/* Maps::Tiles hot fields */
+inline u8& Maps::Tiles::mp2_object()
+{
+    return world.vec_hot.objects[maps_index];
+}
+
+inline u8 Maps::Tiles::mp2_object() const
+{
+    return world.vec_hot.objects[maps_index];
+}
+
+inline u16& Maps::Tiles::tile_passable()
+{
+    return world.vec_hot.passable[maps_index];
+}
+
+inline u16 Maps::Tiles::tile_passable() const
+{
+    return world.vec_hot.passable[maps_index];
+}
+
+inline u16& Maps::Tiles::pack_sprite_index()
+{
+    return world.vec_hot.sprites[maps_index];
+}
+
+inline u16 Maps::Tiles::pack_sprite_index() const
+{
+    return world.vec_hot.sprites[maps_index];
+}
+
+inline u8& Maps::Tiles::quantity1()
+{
+    return world.vec_hot.quantity1[maps_index];
+}
+
+inline u8 Maps::Tiles::quantity1() const
+{
+    return world.vec_hot.quantity1[maps_index];
+}
+
+inline u8& Maps::Tiles::quantity2()
+{
+    return world.vec_hot.quantity2[maps_index];
+}
+
+inline u8 Maps::Tiles::quantity2() const
+{
+    return world.vec_hot.quantity2[maps_index];
+}
+
+inline u8& Maps::Tiles::quantity3()
+{
+    return world.vec_hot.quantity3[maps_index];
+}
+
+inline u8 Maps::Tiles::quantity3() const
+{
+    return world.vec_hot.quantity3[maps_index];
+}
+
+inline int Maps::Tiles::GetQuantity1() const
+{
+    return quantity1();
+}
+
+inline int Maps::Tiles::GetQuantity2() const
+{
+    return quantity2();
+}
+
+inline bool Maps::Tiles::isObject(int obj) const
+{
+    return obj == mp2_object();
+}
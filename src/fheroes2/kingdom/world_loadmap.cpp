@@ -22,6 +22,7 @@
 
 #include "error.h"
 #include <algorithm>
+#include <atomic>
 #include "agg.h"
 #include "artifact.h"
 #include "resource.h"
@@ -39,7 +40,7 @@
 
 namespace GameStatic
 {
-    extern uint32_t uniq;
+    extern atomic<uint32_t> uniq;
 }
 
 bool World::LoadMapMAP(const string& filename)
@@ -145,6 +146,9 @@ bool World::LoadMapMP2(const string& filename)
     fs.seek(MP2OFFSETDATA);
 
     vec_tiles.resize(w() * h());
+    vec_hot.Reset(w() * h());
+    vec_fog.Reset(w(), h());
+    vec_changes.Reset(w() * h());
 
     // read all tiles
     for (auto it = vec_tiles.begin(); it != vec_tiles.end(); ++it)
@@ -673,6 +677,10 @@ void World::PostLoad()
                  tile.UpdatePassable();
              });
 
+    // pathfinder passable layer
+    vec_passable.Build();
+    vec_objects.Build();
+
     // play with hero
     vec_kingdoms.ApplyPlayWithStartingHero();
 
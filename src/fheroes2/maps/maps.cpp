@@ -322,11 +322,11 @@ void Maps::ClearFog(s32 index, int scoute, int color)
 
     int colors = conf.ExtUnionsAllowViewMaps() ? Players::GetPlayerFriends(color) : color;
 
-    for (s32 y = center.y - scoute; y <= center.y + scoute; ++y)
-        for (s32 x = center.x - scoute; x <= center.x + scoute; ++x)
-            if (isValidAbsPoint(x, y) &&
-                scoute + scoute / 2 >= abs(x - center.x) + abs(y - center.y))
-                world.GetTiles(GetIndexFromAbsPoint(x, y)).ClearFog(colors);
+    Indexes changed;
+    world.vec_fog.ClearFog(center.x, center.y, scoute, colors, changed);
+
+    for (const s32 it : changed)
+        world.GetTiles(it).UpdateVersion();
 }
 
 Maps::Indexes Maps::ScanAroundObjects(s32 center, const u8* objs)
@@ -426,35 +426,41 @@ bool Maps::IsNearTiles(s32 index1, s32 index2)
 
 bool Maps::TileIsUnderProtection(s32 center)
 {
-    return MP2::OBJ_MONSTER == world.GetTiles(center).GetObject() || !GetTilesUnderProtection(center).empty();
+    return 0 != world.vec_passable.GetGuards(center);
 }
 
-namespace
+int Maps::ScanTileGuards(s32 center)
 {
-    Maps::Indexes tilesIndexesUnderProtection;
+    int guards = 0;
+    MapsIndexes monsters;
+    ScanAroundObject(center, MP2::OBJ_MONSTER, monsters);
+
+    for (const s32 monster : monsters)
+        if (MapsTileIsUnderProtection(monster, center))
+            guards |= Direction::Get(center, monster);
+
+    if (MP2::OBJ_MONSTER == world.GetTiles(center).GetObject())
+        guards |= Direction::CENTER;
+
+    return guards;
 }
 
 Maps::Indexes Maps::GetTilesUnderProtection(s32 center)
 {
-    ScanAroundObject(center, MP2::OBJ_MONSTER, tilesIndexesUnderProtection);
+    Indexes result;
+    const int guards = world.vec_passable.GetGuards(center);
 
-    if (!tilesIndexesUnderProtection.empty())
+    if (guards & DIRECTION_AROUND)
     {
-        auto removeIt = remove_if(
-            tilesIndexesUnderProtection.begin(), tilesIndexesUnderProtection.end(),
-            [&](auto& it)
-            {
-                return !MapsTileIsUnderProtection(it, center);
-            });
-        int distVal = distance(tilesIndexesUnderProtection.begin(),
-                               removeIt);
-        tilesIndexesUnderProtection.resize(distVal);
+        for (const int direction : Direction::All())
+            if (guards & direction)
+                result.push_back(GetDirectionIndex(center, direction));
     }
 
-    if (MP2::OBJ_MONSTER == world.GetTiles(center).GetObject())
-        tilesIndexesUnderProtection.push_back(center);
+    if (guards & Direction::CENTER)
+        result.push_back(center);
 
-    return tilesIndexesUnderProtection;
+    return result;
 }
 
 uint32_t Maps::GetApproximateDistance(s32 index1, s32 index2)
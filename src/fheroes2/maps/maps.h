@@ -137,6 +137,9 @@ namespace Maps
 
     bool TileIsUnderProtection(s32);
 
+    /* guarding monsters as directions from the tile, CENTER for monster on tile; full scan, see PassableLayer */
+    int ScanTileGuards(s32);
+
     bool IsNearTiles(s32, s32);
 
     Indexes GetObjectPositions(int obj, bool check_hero);
@@ -0,0 +1,182 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include "maps_fog.h"
+#include "direction.h"
+#include "color.h"
+
+void Maps::FogLayer::Reset(s32 w, s32 h)
+{
+    width = w;
+    height = h;
+    stride = (w + BITS - 1) / BITS;
+
+    for (std::vector<uint64_t>& plane : planes)
+        plane.assign(stride * height, ~uint64_t(0));
+}
+
+void Maps::FogLayer::Clear()
+{
+    for (std::vector<uint64_t>& plane : planes)
+        plane.clear();
+
+    width = 0;
+    height = 0;
+    stride = 0;
+}
+
+uint64_t Maps::FogLayer::Word(s32 y, s32 word, int colors) const
+{
+    uint64_t res = ~uint64_t(0);
+
+    for (int ii = 0; ii < PLANES; ++ii)
+        if (colors & (1 << ii))
+            res &= planes[ii][y * stride + word];
+
+    return res;
+}
+
+bool Maps::FogLayer::Bit(s32 x, s32 y, int colors) const
+{
+    if (x < 0 || y < 0 || x >= width || y >= height)
+        return true;
+
+    return 0 != (Word(y, x / BITS, colors) >> (x % BITS) & 1);
+}
+
+int Maps::FogLayer::Get(s32 index) const
+{
+    if (index < 0 || index >= width * height)
+        return Color::ALL;
+
+    const s32 pos = index / width * stride + index % width / BITS;
+    const uint64_t bit = uint64_t(1) << (index % width % BITS);
+    int res = 0;
+
+    for (int ii = 0; ii < PLANES; ++ii)
+        if (planes[ii][pos] & bit)
+            res |= 1 << ii;
+
+    return res;
+}
+
+void Maps::FogLayer::Set(s32 index, int colors)
+{
+    if (index < 0 || index >= width * height)
+        return;
+
+    const s32 pos = index / width * stride + index % width / BITS;
+    const uint64_t bit = uint64_t(1) << (index % width % BITS);
+
+    for (int ii = 0; ii < PLANES; ++ii)
+        if (colors & (1 << ii))
+            planes[ii][pos] |= bit;
+        else
+            planes[ii][pos] &= ~bit;
+}
+
+bool Maps::FogLayer::isFog(s32 index, int colors) const
+{
+    if (index < 0 || index >= width * height)
+        return true;
+
+    return Bit(index % width, index / width, colors);
+}
+
+bool Maps::FogLayer::ClearFog(s32 index, int colors)
+{
+    if (index < 0 || index >= width * height)
+        return false;
+
+    const s32 pos = index / width * stride + index % width / BITS;
+    const uint64_t bit = uint64_t(1) << (index % width % BITS);
+    uint64_t any = 0;
+
+    for (int ii = 0; ii < PLANES; ++ii)
+        if (colors & (1 << ii))
+        {
+            any |= planes[ii][pos] & bit;
+            planes[ii][pos] &= ~bit;
+        }
+
+    return 0 != any;
+}
+
+void Maps::FogLayer::ClearFog(s32 cx, s32 cy, int scoute, int colors, std::vector<s32>& changed)
+{
+    const s32 y1 = std::max(0, cy - scoute);
+    const s32 y2 = std::min(height - 1, cy + scoute);
+
+    for (s32 y = y1; y <= y2; ++y)
+    {
+        // the area is the scoute square cut to the diamond scoute + scoute / 2
+        const s32 half = std::min(scoute, scoute + scoute / 2 - std::abs(y - cy));
+        if (half < 0) continue;
+
+        const s32 x1 = std::max(0, cx - half);
+        const s32 x2 = std::min(width - 1, cx + half);
+        if (x1 > x2) continue;
+
+        for (s32 word = x1 / BITS; word <= x2 / BITS; ++word)
+        {
+            const s32 lo = std::max(x1, word * BITS) - word * BITS;
+            const s32 hi = std::min(x2, word * BITS + BITS - 1) - word * BITS;
+            const uint64_t mask = (~uint64_t(0) >> (BITS - 1 - hi)) & (~uint64_t(0) << lo);
+            const s32 pos = y * stride + word;
+            uint64_t any = 0;
+
+            for (int ii = 0; ii < PLANES; ++ii)
+                if (colors & (1 << ii))
+                {
+                    any |= planes[ii][pos] & mask;
+                    planes[ii][pos] &= ~mask;
+                }
+
+            if (any)
+                for (s32 bit = lo; bit <= hi; ++bit)
+                    if (any >> bit & 1)
+                        changed.push_back(y * width + word * BITS + bit);
+        }
+    }
+}
+
+int Maps::FogLayer::GetAround(s32 index, int colors) const
+{
+    if (index < 0 || index >= width * height)
+        return DIRECTION_ALL;
+
+    const s32 x = index % width;
+    const s32 y = index / width;
+    int around = 0;
+
+    if (Bit(x - 1, y - 1, colors)) around |= Direction::TOP_LEFT;
+    if (Bit(x, y - 1, colors)) around |= Direction::TOP;
+    if (Bit(x + 1, y - 1, colors)) around |= Direction::TOP_RIGHT;
+    if (Bit(x - 1, y, colors)) around |= Direction::LEFT;
+    if (Bit(x, y, colors)) around |= Direction::CENTER;
+    if (Bit(x + 1, y, colors)) around |= Direction::RIGHT;
+    if (Bit(x - 1, y + 1, colors)) around |= Direction::BOTTOM_LEFT;
+    if (Bit(x, y + 1, colors)) around |= Direction::BOTTOM;
+    if (Bit(x + 1, y + 1, colors)) around |= Direction::BOTTOM_RIGHT;
+
+    return around;
+}
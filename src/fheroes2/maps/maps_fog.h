@@ -0,0 +1,71 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "types.h"
+
+namespace Maps
+{
+    /* fog of war of all world tiles, one bit plane per color, bit set is fog */
+    class FogLayer
+    {
+    public:
+        /* size the planes, all tiles fogged for all colors */
+        void Reset(s32 width, s32 height);
+
+        void Clear();
+
+        /* colors which see fog on the tile */
+        int Get(s32 index) const;
+
+        void Set(s32 index, int colors);
+
+        /* colors may be the union friends: fog for every one of them */
+        bool isFog(s32 index, int colors) const;
+
+        /* return true if any of colors had fog there */
+        bool ClearFog(s32 index, int colors);
+
+        /* reveal the scoute area around center (see Maps::ClearFog), tiles with fog removed are added to changed */
+        void ClearFog(s32 cx, s32 cy, int scoute, int colors, std::vector<s32>& changed);
+
+        /* directions around index (and Direction::CENTER) with fog, out of the map counts as fog */
+        int GetAround(s32 index, int colors) const;
+
+    private:
+        enum
+        {
+            PLANES = 6,
+            BITS = 64
+        };
+
+        uint64_t Word(s32 y, s32 word, int colors) const;
+
+        bool Bit(s32 x, s32 y, int colors) const;
+
+        std::vector<uint64_t> planes[PLANES];
+        s32 width = 0;
+        s32 height = 0;
+        s32 stride = 0; // words per row
+    };
+}
@@ -0,0 +1,112 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "maps_index.h"
+#include "maps_tiles.h"
+#include "world.h"
+
+void Maps::ObjectsIndex::Build()
+{
+    Clear();
+
+    const s32 count = world.w() * world.h();
+    slots.resize(count);
+
+    for (s32 index = 0; index < count; ++index)
+    {
+        std::vector<s32>& indexes = objects[world.GetTiles(index).GetObject()];
+        slots[index] = indexes.size();
+        indexes.push_back(index);
+    }
+}
+
+void Maps::ObjectsIndex::Clear()
+{
+    for (std::vector<s32>& indexes : objects)
+        indexes.clear();
+
+    slots.clear();
+}
+
+void Maps::ObjectsIndex::Move(s32 index, int from, int to)
+{
+    // tiles changed before Build are picked up by it
+    if (index < 0 || index >= static_cast<s32>(slots.size()))
+        return;
+
+    std::vector<s32>& src = objects[from & 0xFF];
+    const u32 slot = slots[index];
+
+    if (slot >= src.size() || src[slot] != index)
+        return;
+
+    // order inside a group is not kept
+    src[slot] = src.back();
+    slots[src[slot]] = slot;
+    src.pop_back();
+
+    std::vector<s32>& dst = objects[to & 0xFF];
+    slots[index] = dst.size();
+    dst.push_back(index);
+}
+
+void Maps::ChangedTiles::Reset(s32 count)
+{
+    marks.assign(count, 0);
+    changes.clear();
+    all = true;
+}
+
+void Maps::ChangedTiles::Clear()
+{
+    for (const s32 index : changes)
+        marks[index] = 0;
+
+    changes.clear();
+    all = false;
+}
+
+void Maps::ChangedTiles::SetChanged(s32 index)
+{
+    if (all || index < 0 || index >= static_cast<s32>(marks.size()) || marks[index])
+        return;
+
+    // too many changes: cheaper to redraw all
+    if (changes.size() >= marks.size() / 4)
+    {
+        Clear();
+        all = true;
+    }
+    else
+    {
+        marks[index] = 1;
+        changes.push_back(index);
+    }
+}
+
+void Maps::ChangedTiles::Take(std::vector<s32>& indexes)
+{
+    indexes.clear();
+
+    for (const s32 index : changes)
+        marks[index] = 0;
+
+    indexes.swap(changes);
+}
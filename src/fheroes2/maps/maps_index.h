@@ -0,0 +1,78 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include "types.h"
+
+namespace Maps
+{
+    /* tile indexes of the world grouped by mp2 object, kept in sync with Tiles::SetObject */
+    class ObjectsIndex
+    {
+    public:
+        void Build();
+
+        void Clear();
+
+        void Move(s32 index, int from, int to);
+
+        const std::vector<s32>& Get(int object) const
+        {
+            return objects[object & 0xFF];
+        }
+
+    private:
+        std::vector<s32> objects[256];
+        std::vector<u32> slots; // position of each tile inside its group
+    };
+
+    /* tiles changed since the last Take, for the views which keep their own picture of the world */
+    class ChangedTiles
+    {
+    public:
+        /* size for count tiles, everything changed */
+        void Reset(s32 count);
+
+        /* nothing changed, after the view redraws all */
+        void Clear();
+
+        void SetChanged(s32);
+
+        void SetAll()
+        {
+            all = true;
+        }
+
+        bool isAll() const
+        {
+            return all;
+        }
+
+        /* move out the changed indexes */
+        void Take(std::vector<s32>&);
+
+    private:
+        std::vector<u8> marks;
+        std::vector<s32> changes;
+        bool all = true;
+    };
+}
@@ -0,0 +1,120 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "maps_passable.h"
+#include "maps_tiles.h"
+#include "world.h"
+#include "mp2.h"
+
+void Maps::PassableLayer::Build()
+{
+    tiles.assign(world.w() * world.h(), TilePassable());
+    changes.clear();
+    rebuild = false;
+
+    for (s32 index = 0; index < static_cast<s32>(tiles.size()); ++index)
+        Update(index);
+}
+
+void Maps::PassableLayer::Clear()
+{
+    tiles.clear();
+    changes.clear();
+    rebuild = false;
+}
+
+void Maps::PassableLayer::SetChanged(s32 index)
+{
+    if (rebuild || index < 0 || index >= static_cast<s32>(tiles.size()))
+        return;
+
+    // too many changes: cheaper to rebuild all
+    if (changes.size() >= tiles.size())
+    {
+        changes.clear();
+        rebuild = true;
+    }
+    else
+        changes.push_back(index);
+}
+
+void Maps::PassableLayer::Refresh()
+{
+    if (rebuild)
+    {
+        Build();
+        return;
+    }
+
+    if (changes.empty())
+        return;
+
+    const Size wSize(world.w(), world.h());
+    const Directions& directions = Direction::All();
+
+    for (const s32 index : changes)
+    {
+        Update(index);
+
+        // monster protection of around tiles depends on this tile
+        for (const int direction : directions)
+            if (isValidDirection(index, direction, wSize))
+                Update(GetDirectionIndex(index, direction));
+    }
+    changes.clear();
+}
+
+int Maps::PassableLayer::GetGuards(s32 index)
+{
+    // not built yet: map loading
+    if (tiles.empty() || tiles.size() != world.vec_tiles.size())
+        return ScanTileGuards(index);
+
+    Refresh();
+    return tiles[index].guards;
+}
+
+void Maps::PassableLayer::Update(s32 index)
+{
+    const Tiles& tile = world.GetTiles(index);
+    TilePassable& pass = tiles[index];
+
+    const int object = tile.GetObject();
+    const int base = tile.GetObject(false);
+
+    pass.direct = tile.GetPassable();
+    pass.object = object;
+    pass.fog = 0;
+    for (int color = Color::BLUE; color & Color::ALL; color <<= 1)
+        if (tile.isFog(color)) pass.fog |= color;
+
+    pass.flags = 0;
+    if (tile.isWater()) pass.flags |= PASS_WATER;
+    if (MP2::isActionObject(object, false)) pass.flags |= PASS_ACTION;
+    if (MP2::isActionObject(object, true)) pass.flags |= PASS_ACTION_WATER;
+    if (MP2::isActionObject(base, false)) pass.flags |= PASS_BASE_ACTION;
+    if (MP2::isActionObject(base, true)) pass.flags |= PASS_BASE_ACTION_WATER;
+    if (MP2::isPickupObject(object)) pass.flags |= PASS_PICKUP;
+    if (tile.isPassable(false)) pass.flags |= PASS_HERO;
+    if (tile.isPassable(true)) pass.flags |= PASS_SHIP;
+
+    pass.guards = ScanTileGuards(index);
+    if (pass.guards) pass.flags |= PASS_GUARDED;
+}
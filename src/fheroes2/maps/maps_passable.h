@@ -0,0 +1,99 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include "types.h"
+
+namespace Maps
+{
+    class Tiles;
+
+    enum passable_t
+    {
+        PASS_WATER = 0x0001,
+        PASS_ACTION = 0x0002, // action object on ground
+        PASS_ACTION_WATER = 0x0004, // action object for ship
+        PASS_BASE_ACTION = 0x0008, // action object under hero, on ground
+        PASS_BASE_ACTION_WATER = 0x0010, // action object under hero, for ship
+        PASS_PICKUP = 0x0020,
+        PASS_HERO = 0x0040, // hero can stand on ground
+        PASS_SHIP = 0x0080, // hero can stand on ship
+        PASS_GUARDED = 0x0100 // monster or monster protection
+    };
+
+    /* the tile fields used by the pathfinder and monster protection, packed */
+    struct TilePassable
+    {
+        u16 direct = 0;
+        u16 flags = 0;
+        u16 guards = 0; // directions to guarding monsters
+        u8 object = 0;
+        u8 fog = 0;
+
+        bool isFog(int colors) const
+        {
+            return (fog & colors) == colors;
+        }
+
+        bool isAction(bool base, bool ship) const
+        {
+            return 0 != (flags & (base ? (ship ? PASS_BASE_ACTION_WATER : PASS_BASE_ACTION)
+                                       : (ship ? PASS_ACTION_WATER : PASS_ACTION)));
+        }
+
+        // see Tiles::isPassable(const Heroes*, int, bool)
+        bool isPassable(bool hero, bool ship, int dir, bool skipfog, int color) const
+        {
+            if (!skipfog && isFog(color))
+                return false;
+
+            return !(hero && !(flags & (ship ? PASS_SHIP : PASS_HERO))) && dir & direct;
+        }
+    };
+
+    /* passability of all world tiles, kept in sync with tile changes */
+    class PassableLayer
+    {
+    public:
+        void Build();
+
+        void Clear();
+
+        void SetChanged(s32);
+
+        void Refresh();
+
+        const TilePassable& Get(s32 index) const
+        {
+            return tiles[index];
+        }
+
+        int GetGuards(s32);
+
+    private:
+        void Update(s32);
+
+        std::vector<TilePassable> tiles;
+        std::vector<s32> changes;
+        bool rebuild = false;
+    };
+}
@@ -22,6 +22,7 @@
 
 #include <iomanip>
 #include <algorithm>
+#include <memory>
 #include "agg.h"
 #include "world.h"
 #include "race.h"
@@ -48,6 +49,11 @@
 
 u8 monster_animation_cicle[] = {0, 1, 2, 1, 0, 3, 4, 5, 4, 3};
 
+namespace
+{
+    uint32_t tiles_version = 0;
+}
+
 
 Maps::TilesAddon::TilesAddon() : uniq(0), level(0), object(0), index(0), tmp(0)
 {
@@ -1023,16 +1029,195 @@ bool Maps::TilesAddon::ForceLevel2(const TilesAddon& ta)
     return false;
 }
 
+namespace Maps
+{
+    /* fixed blocks are never moved: a range stays contiguous and its addresses stable,
+     * released ranges are kept on a free list per power of two capacity */
+    class AddonArena
+    {
+    public:
+        static AddonArena& Get()
+        {
+            return *Current();
+        }
+
+        // the world arena is never destroyed: tiles of the global world outlive any static arena
+        static AddonArena*& Current()
+        {
+            static AddonArena* arena = new AddonArena;
+            return arena;
+        }
+
+        Maps::TilesAddon* Allocate(uint32_t capacity)
+        {
+            vector<Maps::TilesAddon*>& slots = free_lists[Class(capacity)];
+
+            if (!slots.empty())
+            {
+                Maps::TilesAddon* res = slots.back();
+                slots.pop_back();
+                reserved += capacity;
+                return res;
+            }
+
+            if (blocks.empty() || used + capacity > BLOCK_SIZE)
+            {
+                blocks.emplace_back(new Maps::TilesAddon[BLOCK_SIZE]);
+                used = 0;
+            }
+
+            Maps::TilesAddon* res = &blocks.back()[used];
+            used += capacity;
+            reserved += capacity;
+            return res;
+        }
+
+        void Release(Maps::TilesAddon* items, uint32_t capacity)
+        {
+            if (!items) return;
+
+            free_lists[Class(capacity)].push_back(items);
+            reserved -= capacity;
+        }
+
+        static uint32_t Capacity(uint32_t count)
+        {
+            uint32_t res = 1;
+            while (res < count) res <<= 1;
+            return res;
+        }
+
+        // the largest range fits one block
+        enum
+        {
+            MAX_RANGE = 4096
+        };
+
+        string Info() const
+        {
+            ostringstream os;
+            os << "addon arena: reserved " << reserved << ", blocks " << blocks.size() << ", bytes " <<
+                blocks.size() * BLOCK_SIZE * sizeof(Maps::TilesAddon);
+            return os.str();
+        }
+
+    private:
+        enum
+        {
+            BLOCK_SIZE = MAX_RANGE,
+            CLASSES = 13
+        };
+
+        static uint32_t Class(uint32_t capacity)
+        {
+            uint32_t res = 0;
+            while ((1u << res) < capacity) ++res;
+            return res;
+        }
+
+        vector<unique_ptr<Maps::TilesAddon[]>> blocks;
+        vector<Maps::TilesAddon*> free_lists[CLASSES];
+        uint32_t used = 0;
+        uint32_t reserved = 0;
+    };
+}
+
 /* Maps::Addons */
-void Maps::Addons::Remove(uint32_t uniq)
+Maps::Addons::Addons(const Addons& other)
+{
+    *this = other;
+}
+
+Maps::Addons::Addons(Addons&& other) noexcept : items(other.items), count(other.count), capacity(other.capacity)
+{
+    other.items = nullptr;
+    other.count = 0;
+    other.capacity = 0;
+}
+
+Maps::Addons::~Addons()
+{
+    AddonArena::Get().Release(items, capacity);
+}
+
+Maps::Addons& Maps::Addons::operator=(const Addons& other)
 {
-    Addons clean;
-    for (auto& addon : _items)
+    if (this != &other)
     {
-        if (!addon.isUniq(uniq))
-            clean._items.push_back(addon);
+        clear();
+        reserve(other.count);
+        std::copy(other.begin(), other.end(), items);
+        count = other.count;
     }
-    *this = clean;
+    return *this;
+}
+
+Maps::Addons& Maps::Addons::operator=(Addons&& other) noexcept
+{
+    std::swap(items, other.items);
+    std::swap(count, other.count);
+    std::swap(capacity, other.capacity);
+    return *this;
+}
+
+void Maps::Addons::reserve(uint32_t size)
+{
+    size = std::min<uint32_t>(size, AddonArena::MAX_RANGE);
+    if (size <= capacity)
+        return;
+
+    AddonArena& arena = AddonArena::Get();
+    const uint32_t grow = AddonArena::Capacity(size);
+    TilesAddon* moved = arena.Allocate(grow);
+
+    std::copy(begin(), end(), moved);
+    arena.Release(items, capacity);
+    items = moved;
+    capacity = grow;
+}
+
+void Maps::Addons::push_back(const TilesAddon& ta)
+{
+    if (count == AddonArena::MAX_RANGE)
+        return;
+
+    if (count == capacity)
+    {
+        // ta may live in this range
+        const TilesAddon copy = ta;
+        reserve(count + 1);
+        items[count++] = copy;
+    }
+    else
+        items[count++] = ta;
+}
+
+/* keeps the range for the next push */
+void Maps::Addons::clear()
+{
+    count = 0;
+}
+
+void Maps::Addons::Remove(uint32_t uniq)
+{
+    count = std::remove_if(begin(), end(),
+                           [uniq](const TilesAddon& addon) { return addon.isUniq(uniq); }) - begin();
+}
+
+string Maps::Addons::ArenaInfo()
+{
+    return AddonArena::Get().Info();
+}
+
+Maps::ScopedAddonArena::ScopedAddonArena() : arena(new AddonArena), saved(AddonArena::Current())
+{
+    AddonArena::Current() = arena;
+}
+
+Maps::ScopedAddonArena::~ScopedAddonArena()
+{
+    AddonArena::Current() = saved;
+    delete arena;
 }
 
 uint32_t PackTileSpriteIndex(uint32_t index, uint32_t shape) /* index max: 0x3FFF, shape value: 0, 1, 2, 3 */
@@ -1041,25 +1226,25 @@ uint32_t PackTileSpriteIndex(uint32_t index, uint32_t shape) /* index max: 0x3FF
 }
 
 /* Maps::Tiles */
-Maps::Tiles::Tiles() : maps_index(0), pack_sprite_index(0), tile_passable(DIRECTION_ALL),
-                       mp2_object(0), fog_colors(Color::ALL), quantity1(0), quantity2(0), quantity3(0)
+Maps::Tiles::Tiles() : maps_index(0)
 {
 }
 
 void Maps::Tiles::Init(s32 index, const MP2::mp2tile_t& mp2)
 {
-    tile_passable = DIRECTION_ALL;
-    quantity1 = mp2.quantity1;
-    quantity2 = mp2.quantity2;
-    quantity3 = 0;
-    fog_colors = Color::ALL;
+    // the hot fields are in the world layer by the index
+    SetIndex(index);
+    tile_passable() = DIRECTION_ALL;
+    quantity1() = mp2.quantity1;
+    quantity2() = mp2.quantity2;
+    quantity3() = 0;
 
     SetTile(mp2.tileIndex, mp2.shape);
-    SetIndex(index);
+    world.vec_fog.Set(index, Color::ALL);
     SetObject(mp2.generalObject);
 
-    addons_level1._items.clear();
-    addons_level2._items.clear();
+    addons_level1.clear();
+    addons_level2.clear();
 
     AddonsPushLevel1(mp2);
     AddonsPushLevel2(mp2);
@@ -1072,24 +1257,24 @@ void Maps::Tiles::SetIndex(int index)
 
 int Maps::Tiles::GetQuantity3() const
 {
-    return quantity3;
+    return quantity3();
 }
 
 void Maps::Tiles::SetQuantity3(int mod)
 {
-    quantity3 = mod;
+    quantity3() = mod;
 }
 
 Heroes* Maps::Tiles::GetHeroes() const
 {
-    return MP2::OBJ_HEROES == mp2_object && GetQuantity3() ? world.GetHeroes(GetQuantity3() - 1) : nullptr;
+    return MP2::OBJ_HEROES == mp2_object() && GetQuantity3() ? world.GetHeroes(GetQuantity3() - 1) : nullptr;
 }
 
 void Maps::Tiles::SetHeroes(Heroes* hero)
 {
     if (hero)
     {
-        hero->SetMapsObject(mp2_object);
+        hero->SetMapsObject(mp2_object());
         SetQuantity3(hero->GetID() + 1);
         SetObject(MP2::OBJ_HEROES);
     }
@@ -1121,33 +1306,55 @@ s32 Maps::Tiles::GetIndex() const
 
 int Maps::Tiles::GetObject(bool skip_hero /* true */) const
 {
-    if (!skip_hero && MP2::OBJ_HEROES == mp2_object)
+    if (!skip_hero && MP2::OBJ_HEROES == mp2_object())
     {
         const Heroes* hero = GetHeroes();
         return hero ? hero->GetMapsObject() : MP2::OBJ_ZERO;
     }
 
-    return mp2_object;
+    return mp2_object();
 }
 
 void Maps::Tiles::SetObject(int object)
 {
-    mp2_object = object;
+    if (mp2_object() != object)
+    {
+        world.vec_objects.Move(maps_index, mp2_object(), object);
+        UpdateVersion();
+    }
+    mp2_object() = object;
+}
+
+uint32_t Maps::Tiles::GetVersion()
+{
+    return tiles_version;
+}
+
+void Maps::Tiles::RestoreVersion(uint32_t version)
+{
+    tiles_version = version;
+}
+
+void Maps::Tiles::UpdateVersion()
+{
+    ++tiles_version;
+    world.vec_passable.SetChanged(maps_index);
+    world.vec_changes.SetChanged(maps_index);
 }
 
 void Maps::Tiles::SetTile(uint32_t sprite_index, uint32_t shape)
 {
-    pack_sprite_index = PackTileSpriteIndex(sprite_index, shape);
+    pack_sprite_index() = PackTileSpriteIndex(sprite_index, shape);
 }
 
 uint32_t Maps::Tiles::TileSpriteIndex() const
 {
-    return pack_sprite_index & 0x3FFF;
+    return pack_sprite_index() & 0x3FFF;
 }
 
 uint32_t Maps::Tiles::TileSpriteShape() const
 {
-    return pack_sprite_index >> 14;
+    return pack_sprite_index() >> 14;
 }
 
 Surface Maps::Tiles::GetTileSurface() const
@@ -1174,7 +1381,7 @@ bool Exclude4LongObject(const Maps::TilesAddon& ta)
 
 bool HaveLongObjectUniq(const Maps::Addons& level, uint32_t uid)
 {
-    for (const auto& it : level._items)
+    for (const auto& it : level)
         if (!Exclude4LongObject(it) && it.isUniq(uid)) return true;
     return false;
 }
@@ -1193,7 +1400,7 @@ bool Maps::Tiles::isLongObject(int direction)
     }
     Tiles& tile = world.GetTiles(GetDirectionIndex(GetIndex(), direction));
 
-    for (const auto& it : addons_level1._items)
+    for (const auto& it : addons_level1)
         if (!Exclude4LongObject(it) &&
             (HaveLongObjectUniq(tile.addons_level1, it.uniq) ||
                 (!TilesAddon::isTrees(it) && HaveLongObjectUniq(tile.addons_level2, it.uniq))))
@@ -1203,66 +1410,67 @@ bool Maps::Tiles::isLongObject(int direction)
 
 void Maps::Tiles::UpdatePassable()
 {
-    tile_passable = DIRECTION_ALL;
+    UpdateVersion();
+    tile_passable() = DIRECTION_ALL;
 
     const int obj = GetObject(false);
     bool emptyobj = MP2::OBJ_ZERO == obj || MP2::OBJ_COAST == obj || MP2::OBJ_EVENT == obj;
 
     if (MP2::isActionObject(obj, isWater()))
     {
-        tile_passable = MP2::GetObjectDirect(obj);
+        tile_passable() = MP2::GetObjectDirect(obj);
         return;
     }
 
     Size wSize(world.w(), world.h());
     // on ground
-    if (MP2::OBJ_HEROES != mp2_object && !isWater())
+    if (MP2::OBJ_HEROES != mp2_object() && !isWater())
     {
-        bool mounts1 = addons_level1._items.end() != find_if(addons_level1._items.begin(), addons_level1._items.end(),
+        bool mounts1 = addons_level1.end() != find_if(addons_level1.begin(), addons_level1.end(),
                                                              isMountsRocs);
-        bool mounts2 = addons_level2._items.end() != find_if(addons_level2._items.begin(), addons_level2._items.end(),
+        bool mounts2 = addons_level2.end() != find_if(addons_level2.begin(), addons_level2.end(),
                                                              isMountsRocs);
-        bool trees1 = addons_level1._items.end() != find_if(addons_level1._items.begin(), addons_level1._items.end(),
+        bool trees1 = addons_level1.end() != find_if(addons_level1.begin(), addons_level1.end(),
                                                             isForestsTrees);
-        bool trees2 = addons_level2._items.end() != find_if(addons_level2._items.begin(), addons_level2._items.end(),
+        bool trees2 = addons_level2.end() != find_if(addons_level2.begin(), addons_level2.end(),
                                                             isForestsTrees);
 
         // fix coast passable
-        if (tile_passable &&
+        if (tile_passable() &&
             //! MP2::isActionObject(obj, false) &&
             !emptyobj &&
             TileIsCoast(GetIndex(), Direction::TOP | Direction::BOTTOM | Direction::LEFT | Direction::RIGHT) &&
-            addons_level1._items.size() != static_cast<size_t>(count_if(
-                addons_level1._items.begin(), addons_level1._items.end(),
+            addons_level1.size() != static_cast<size_t>(count_if(
+                addons_level1.begin(), addons_level1.end(),
                 [](const TilesAddon& it)
                 {
                     return TilesAddon::isShadow(it);
                 })))
         {
-            tile_passable = 0;
+            tile_passable() = 0;
         }
 
         // fix mountain layer
-        if (tile_passable &&
+        if (tile_passable() &&
             (MP2::OBJ_MOUNTS == obj || MP2::OBJ_TREES == obj) &&
             mounts1 && (mounts2 || trees2))
         {
-            tile_passable = 0;
+            tile_passable() = 0;
         }
 
         // fix trees layer
-        if (tile_passable &&
+        if (tile_passable() &&
             (MP2::OBJ_MOUNTS == obj || MP2::OBJ_TREES == obj) &&
             trees1 && (mounts2 || trees2))
         {
-            tile_passable = 0;
+            tile_passable() = 0;
         }
 
         // town twba
-        if (tile_passable &&
+        if (tile_passable() &&
             FindAddonICN1(ICN::OBJNTWBA) && (mounts2 || trees2))
         {
-            tile_passable = 0;
+            tile_passable() = 0;
         }
 
         if (isValidDirection(GetIndex(), Direction::TOP, wSize))
@@ -1270,29 +1478,29 @@ void Maps::Tiles::UpdatePassable()
             Tiles& top = world.GetTiles(GetDirectionIndex(GetIndex(), Direction::TOP));
             // fix: rocs on water
             if (top.isWater() &&
-                top.tile_passable &&
-                !(Direction::TOP & top.tile_passable))
+                top.tile_passable() &&
+                !(Direction::TOP & top.tile_passable()))
             {
-                top.tile_passable = 0;
+                top.tile_passable() = 0;
             }
         }
     }
 
     // fix bottom border: disable passable for all no action objects
-    if (tile_passable &&
+    if (tile_passable() &&
         !isValidDirection(GetIndex(), Direction::BOTTOM, wSize) &&
         !emptyobj &&
         !MP2::isActionObject(obj, isWater()))
     {
-        tile_passable = 0;
+        tile_passable() = 0;
     }
 
     // check all sprite (level 1)
-    for (const auto& it : addons_level1._items)
+    for (const auto& it : addons_level1)
     {
-        if (tile_passable)
+        if (tile_passable())
         {
-            tile_passable &= TilesAddon::GetPassable(it);
+            tile_passable() &= TilesAddon::GetPassable(it);
         }
     }
 
@@ -1302,13 +1510,13 @@ void Maps::Tiles::UpdatePassable()
         Tiles& top = world.GetTiles(GetDirectionIndex(GetIndex(), Direction::TOP));
 
         if (isWater() == top.isWater() &&
-            top.addons_level1._items.end() !=
-            find_if(top.addons_level1._items.begin(), top.addons_level1._items.end(), TopObjectDisable) &&
+            top.addons_level1.end() !=
+            find_if(top.addons_level1.begin(), top.addons_level1.end(), TopObjectDisable) &&
             !MP2::isActionObject(top.GetObject(false), isWater()) &&
-            (tile_passable && !(tile_passable & DIRECTION_TOP_ROW)) &&
-            !(top.tile_passable & DIRECTION_TOP_ROW))
+            (tile_passable() && !(tile_passable() & DIRECTION_TOP_ROW)) &&
+            !(top.tile_passable() & DIRECTION_TOP_ROW))
         {
-            top.tile_passable = 0;
+            top.tile_passable() = 0;
         }
     }
 
@@ -1318,21 +1526,21 @@ void Maps::Tiles::UpdatePassable()
         Tiles& left = world.GetTiles(GetDirectionIndex(GetIndex(), Direction::LEFT));
 
         // left corner
-        if (left.tile_passable &&
+        if (left.tile_passable() &&
             isLongObject(Direction::TOP) &&
-            !((Direction::TOP | Direction::TOP_LEFT) & tile_passable) &&
-            Direction::TOP_RIGHT & left.tile_passable)
+            !((Direction::TOP | Direction::TOP_LEFT) & tile_passable()) &&
+            Direction::TOP_RIGHT & left.tile_passable())
         {
-            left.tile_passable &= ~Direction::TOP_RIGHT;
+            left.tile_passable() &= ~Direction::TOP_RIGHT;
         }
         else
             // right corner
-            if (tile_passable &&
+            if (tile_passable() &&
                 left.isLongObject(Direction::TOP) &&
-                !((Direction::TOP | Direction::TOP_RIGHT) & left.tile_passable) &&
-                Direction::TOP_LEFT & tile_passable)
+                !((Direction::TOP | Direction::TOP_RIGHT) & left.tile_passable()) &&
+                Direction::TOP_LEFT & tile_passable())
             {
-                tile_passable &= ~Direction::TOP_LEFT;
+                tile_passable() &= ~Direction::TOP_LEFT;
             }
     }
 }
@@ -1345,7 +1553,7 @@ uint32_t Maps::Tiles::GetObjectUID(int obj) const
 
 int Maps::Tiles::GetPassable() const
 {
-    return tile_passable;
+    return tile_passable();
 }
 
 void Maps::Tiles::AddonsPushLevel1(const MP2::mp2tile_t& mt)
@@ -1363,9 +1571,9 @@ void Maps::Tiles::AddonsPushLevel1(const MP2::mp2addon_t& ma)
 void Maps::Tiles::AddonsPushLevel1(const TilesAddon& ta)
 {
     if (TilesAddon::ForceLevel2(ta))
-        addons_level2._items.push_back(ta);
+        addons_level2.push_back(ta);
     else
-        addons_level1._items.push_back(ta);
+        addons_level1.push_back(ta);
 }
 
 void Maps::Tiles::AddonsPushLevel2(const MP2::mp2tile_t& mt)
@@ -1383,17 +1591,17 @@ void Maps::Tiles::AddonsPushLevel2(const MP2::mp2addon_t& ma)
 void Maps::Tiles::AddonsPushLevel2(const TilesAddon& ta)
 {
     if (TilesAddon::ForceLevel1(ta))
-        addons_level1._items.push_back(ta);
+        addons_level1.push_back(ta);
     else
-        addons_level2._items.push_back(ta);
+        addons_level2.push_back(ta);
 }
 
 void Maps::Tiles::AddonsSort()
 {
-    if (!addons_level1._items.empty())
-        std::sort(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::PredicateSortRules1);
-    if (!addons_level2._items.empty())
-        std::sort(addons_level2._items.begin(), addons_level2._items.end(), TilesAddon::PredicateSortRules2);
+    if (!addons_level1.empty())
+        std::sort(addons_level1.begin(), addons_level1.end(), TilesAddon::PredicateSortRules1);
+    if (!addons_level2.empty())
+        std::sort(addons_level2.begin(), addons_level2.end(), TilesAddon::PredicateSortRules2);
 }
 
 int Maps::Tiles::GetGround() const
@@ -1430,8 +1638,8 @@ bool Maps::Tiles::isWater() const
 
 void Maps::Tiles::Remove(uint32_t uniq)
 {
-    if (!addons_level1._items.empty()) addons_level1.Remove(uniq);
-    if (!addons_level2._items.empty()) addons_level2.Remove(uniq);
+    if (!addons_level1.empty()) addons_level1.Remove(uniq);
+    if (!addons_level2.empty()) addons_level2.Remove(uniq);
 }
 
 void Maps::Tiles::RedrawTile(Surface& dst) const
@@ -1451,9 +1659,9 @@ void Maps::Tiles::RedrawBottom(Surface& dst, bool skip_objs) const
     const Interface::GameArea& area = Interface::Basic::Get().GetGameArea();
     const Point mp = GetPoint(GetIndex());
 
-    if (!(area.GetRectMaps() & mp) || addons_level1._items.empty())
+    if (!(area.GetRectMaps() & mp) || addons_level1.empty())
         return;
-    for (const auto& it : addons_level1._items)
+    for (const auto& it : addons_level1)
     {
         // skip
         if (skip_objs &&
@@ -1471,7 +1679,7 @@ void Maps::Tiles::RedrawBottom(Surface& dst, bool skip_objs) const
         area.BlitOnTile(dst, sprite, mp);
 
         // possible anime
-        uint32_t anime_index = ICN::AnimationFrame(icn, index, Game::MapsAnimationFrame(), quantity2);
+        uint32_t anime_index = ICN::AnimationFrame(icn, index, Game::MapsAnimationFrame(), quantity2());
         if (anime_index == 0)
             continue;
         const Sprite& anime_sprite = AGG::GetICN(icn, anime_index);
@@ -1483,6 +1691,25 @@ void Maps::Tiles::RedrawPassable(Surface& dst)
 {
 }
 
+/* hint the addon sprites to the background decoder before the tile scrolls in */
+void Maps::Tiles::PrefetchSprites() const
+{
+    for (const Addons* addons : {&addons_level1, &addons_level2})
+        for (const auto& it : *addons)
+        {
+            const int icn = MP2::GetICNObject(it.object);
+
+            if (ICN::UNKNOWN == icn || ICN::MINIHERO == icn || ICN::MONS32 == icn)
+                continue;
+
+            AGG::Prefetch(icn, it.index, 1);
+
+            const uint32_t anime_index = ICN::AnimationFrame(icn, it.index, Game::MapsAnimationFrame(), quantity2());
+            if (anime_index)
+                AGG::Prefetch(icn, anime_index, 1);
+        }
+}
+
 void Maps::Tiles::RedrawObjects(Surface& dst) const
 {
     switch (GetObject())
@@ -1518,7 +1745,7 @@ void Maps::Tiles::RedrawMonster(Surface& dst) const
         const Tiles& tile = world.GetTiles(it);
         dst_index = it;
 
-        if (MP2::OBJ_HEROES != mp2_object ||
+        if (MP2::OBJ_HEROES != mp2_object() ||
             // skip bottom, bottom_right, bottom_left with ground objects
             (DIRECTION_BOTTOM_ROW & Direction::Get(GetIndex(), it) && MP2::isGroundObject(tile.GetObject(false))) ||
             // skip ground check
@@ -1621,11 +1848,11 @@ void Maps::Tiles::RedrawBottom4Hero(Surface& dst) const
     const Interface::GameArea& area = Interface::Basic::Get().GetGameArea();
     const Point mp = GetPoint(GetIndex());
 
-    if (!(area.GetRectMaps() & mp) || addons_level1._items.empty())
+    if (!(area.GetRectMaps() & mp) || addons_level1.empty())
         return;
-    for (const auto& it : addons_level1._items)
+    for (const auto& it : addons_level1)
     {
-        if (SkipRedrawTileBottom4Hero(it, tile_passable))
+        if (SkipRedrawTileBottom4Hero(it, tile_passable()))
             continue;
         const u8& object = it.object;
         const u8& index = it.index;
@@ -1633,7 +1860,7 @@ void Maps::Tiles::RedrawBottom4Hero(Surface& dst) const
 
         const Sprite& sprite = AGG::GetICN(icn, index);
         area.BlitOnTile(dst, sprite, mp);
-        uint32_t anime_index = ICN::AnimationFrame(icn, index, Game::MapsAnimationFrame(), quantity2);
+        uint32_t anime_index = ICN::AnimationFrame(icn, index, Game::MapsAnimationFrame(), quantity2());
         // possible anime
         if (anime_index != 0)
         {
@@ -1671,9 +1898,9 @@ void Maps::Tiles::RedrawTop(Surface& dst, const TilesAddon* skip) const
         }
     }
 
-    if (addons_level2._items.empty())
+    if (addons_level2.empty())
         return;
-    for (const auto& it : addons_level2._items)
+    for (const auto& it : addons_level2)
     {
         if (skip && skip == &it) continue;
 
@@ -1701,9 +1928,9 @@ void Maps::Tiles::RedrawTop4Hero(Surface& dst, bool skip_ground) const
     const Interface::GameArea& area = Interface::Basic::Get().GetGameArea();
     const Point mp = GetPoint(GetIndex());
 
-    if (!(area.GetRectMaps() & mp) || addons_level2._items.empty())
+    if (!(area.GetRectMaps() & mp) || addons_level2.empty())
         return;
-    for (const auto& it : addons_level2._items)
+    for (const auto& it : addons_level2)
     {
         if (skip_ground && MP2::isGroundObject(it.object)) continue;
 
@@ -1727,34 +1954,34 @@ void Maps::Tiles::RedrawTop4Hero(Surface& dst, bool skip_ground) const
 
 Maps::TilesAddon* Maps::Tiles::FindAddonICN1(int icn1)
 {
-    const auto it = find_if(addons_level1._items.begin(), addons_level1._items.end(),
+    const auto it = find_if(addons_level1.begin(), addons_level1.end(),
                             [&](const TilesAddon& it) { return it.isICN(icn1); });
 
-    return it != addons_level1._items.end() ? &*it : nullptr;
+    return it != addons_level1.end() ? &*it : nullptr;
 }
 
 Maps::TilesAddon* Maps::Tiles::FindAddonICN2(int icn2)
 {
-    auto it = find_if(addons_level2._items.begin(), addons_level2._items.end(),
+    auto it = find_if(addons_level2.begin(), addons_level2.end(),
                       [&](const TilesAddon& it) { return it.isICN(icn2); });
 
-    return it != addons_level2._items.end() ? &*it : nullptr;
+    return it != addons_level2.end() ? &*it : nullptr;
 }
 
 Maps::TilesAddon* Maps::Tiles::FindAddonLevel1(uint32_t uniq1)
 {
-    auto it = find_if(addons_level1._items.begin(), addons_level1._items.end(),
+    auto it = find_if(addons_level1.begin(), addons_level1.end(),
                       [&](const TilesAddon& it) { return it.isUniq(uniq1); });
 
-    return it != addons_level1._items.end() ? &*it : nullptr;
+    return it != addons_level1.end() ? &*it : nullptr;
 }
 
 Maps::TilesAddon* Maps::Tiles::FindAddonLevel2(uint32_t uniq2)
 {
-    auto it = find_if(addons_level2._items.begin(), addons_level2._items.end(),
+    auto it = find_if(addons_level2.begin(), addons_level2.end(),
                       [&](const TilesAddon& it) { return it.isUniq(uniq2); });
 
-    return it != addons_level2._items.end() ? &*it : nullptr;
+    return it != addons_level2.end() ? &*it : nullptr;
 }
 
 
@@ -1769,7 +1996,7 @@ string Maps::Tiles::String() const
         "ground          : " << Ground::String(GetGround());
     if (isRoad())
     {
-        auto it = find_if(addons_level1._items.begin(), addons_level1._items.end(),
+        auto it = find_if(addons_level1.begin(), addons_level1.end(),
                           [](const TilesAddon& it)
                           {
                               return it.isRoad(DIRECTION_ALL);
@@ -1780,19 +2007,19 @@ string Maps::Tiles::String() const
         os << ")";
     }
     os << endl <<
-        "passable        : " << (tile_passable ? Direction::String(tile_passable) : "false");
+        "passable        : " << (tile_passable() ? Direction::String(tile_passable()) : "false");
     os <<
         endl <<
         "mp2 object      : " << "0x" << setw(2) << setfill('0') << GetObject() <<
         ", (" << MP2::StringObject(GetObject()) << ")" << endl <<
-        "quantity 1      : " << static_cast<int>(quantity1) << endl <<
-        "quantity 2      : " << static_cast<int>(quantity2) << endl <<
+        "quantity 1      : " << static_cast<int>(quantity1()) << endl <<
+        "quantity 2      : " << static_cast<int>(quantity2()) << endl <<
         "quantity 3      : " << GetQuantity3() << endl;
 
-    for (const auto& it : addons_level1._items)
+    for (const auto& it : addons_level1)
         os << it.String(1);
 
-    for (const auto& it : addons_level2._items)
+    for (const auto& it : addons_level2)
         os << it.String(2);
 
     os <<
@@ -1874,21 +2101,21 @@ string Maps::Tiles::String() const
 
 void Maps::Tiles::FixObject()
 {
-    if (MP2::OBJ_ZERO != mp2_object)
+    if (MP2::OBJ_ZERO != mp2_object())
         return;
-    if (addons_level1._items.end() != find_if(addons_level1._items.begin(), addons_level1._items.end(),
+    if (addons_level1.end() != find_if(addons_level1.begin(), addons_level1.end(),
                                               TilesAddon::isArtifact))
         SetObject(MP2::OBJ_ARTIFACT);
-    else if (addons_level1._items.end() !=
-        find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isResource))
+    else if (addons_level1.end() !=
+        find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isResource))
         SetObject(MP2::OBJ_RESOURCE);
 }
 
 bool Maps::Tiles::GoodForUltimateArtifact() const
 {
-    return !isWater() && (addons_level1._items.empty() ||
-            addons_level1._items.size() ==
-            static_cast<size_t>(count_if(addons_level1._items.begin(), addons_level1._items.end(),
+    return !isWater() && (addons_level1.empty() ||
+            addons_level1.size() ==
+            static_cast<size_t>(count_if(addons_level1.begin(), addons_level1.end(),
                                          [&](const TilesAddon& it) { return TilesAddon::isShadow(it); }))) &&
         isPassable(nullptr, Direction::CENTER, true);
 }
@@ -1901,7 +2128,12 @@ bool TileIsGround(s32 index, int ground)
 /* accept move */
 bool Maps::Tiles::isPassable(const Heroes& hero) const
 {
-    if (hero.isShipMaster())
+    return isPassable(hero.isShipMaster());
+}
+
+bool Maps::Tiles::isPassable(bool shipMaster) const
+{
+    if (shipMaster)
     {
         return isWater() && MP2::OBJ_BOAT != GetObject();
     }
@@ -1943,18 +2175,19 @@ bool Maps::Tiles::isPassable(const Heroes* hero, int direct, bool skipfog) const
     if (!skipfog && isFog(Settings::Get().CurrentColor()))
         return false;
 
-    return !(hero && !isPassable(*hero)) && direct & tile_passable;
+    return !(hero && !isPassable(*hero)) && direct & tile_passable();
 }
 
 void Maps::Tiles::SetObjectPassable(bool pass)
 {
+    UpdateVersion();
     switch (GetObject(false))
     {
     case MP2::OBJ_TROLLBRIDGE:
         if (pass)
-            tile_passable |= Direction::TOP_LEFT;
+            tile_passable() |= Direction::TOP_LEFT;
         else
-            tile_passable &= ~Direction::TOP_LEFT;
+            tile_passable() &= ~Direction::TOP_LEFT;
         break;
 
     default:
@@ -1965,7 +2198,7 @@ void Maps::Tiles::SetObjectPassable(bool pass)
 /* check road */
 bool Maps::Tiles::isRoad(int direct) const
 {
-    for (const auto& addon : addons_level1._items)
+    for (const auto& addon : addons_level1)
     {
         if (addon.isRoad(direct))
             return true;
@@ -1975,7 +2208,7 @@ bool Maps::Tiles::isRoad(int direct) const
 
 bool Maps::Tiles::isStream() const
 {
-    for (const auto& addon : addons_level1._items)
+    for (const auto& addon : addons_level1)
     {
         if (TilesAddon::isStream(addon))
             return true;
@@ -1990,118 +2223,118 @@ Maps::TilesAddon* Maps::Tiles::FindObject(int objs) const
 
 const Maps::TilesAddon* Maps::Tiles::FindObjectConst(int objs) const
 {
-    auto it = !addons_level1._items.empty() ? addons_level1._items.begin() : addons_level1._items.end();
+    auto it = !addons_level1.empty() ? addons_level1.begin() : addons_level1.end();
 
     switch (objs)
     {
     case MP2::OBJ_CAMPFIRE:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isCampFire);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isCampFire);
         break;
 
     case MP2::OBJ_TREASURECHEST:
     case MP2::OBJ_ANCIENTLAMP:
     case MP2::OBJ_RESOURCE:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isResource);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isResource);
         break;
 
     case MP2::OBJ_RNDRESOURCE:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isRandomResource);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isRandomResource);
         break;
 
     case MP2::OBJ_FLOTSAM:
     case MP2::OBJ_SHIPWRECKSURVIROR:
     case MP2::OBJ_WATERCHEST:
     case MP2::OBJ_BOTTLE:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isWaterResource);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isWaterResource);
         break;
 
     case MP2::OBJ_ARTIFACT:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isArtifact);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isArtifact);
         break;
 
     case MP2::OBJ_RNDARTIFACT:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isRandomArtifact);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isRandomArtifact);
         break;
 
     case MP2::OBJ_RNDARTIFACT1:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isRandomArtifact1);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isRandomArtifact1);
         break;
 
     case MP2::OBJ_RNDARTIFACT2:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isRandomArtifact2);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isRandomArtifact2);
         break;
 
     case MP2::OBJ_RNDARTIFACT3:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isRandomArtifact3);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isRandomArtifact3);
         break;
 
     case MP2::OBJ_RNDULTIMATEARTIFACT:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isUltimateArtifact);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isUltimateArtifact);
         break;
 
     case MP2::OBJ_MONSTER:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isMonster);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isMonster);
         break;
 
     case MP2::OBJ_WHIRLPOOL:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isWhirlPool);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isWhirlPool);
         break;
 
     case MP2::OBJ_STANDINGSTONES:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isStandingStone);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isStandingStone);
         break;
 
     case MP2::OBJ_ARTESIANSPRING:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isArtesianSpring);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isArtesianSpring);
         break;
 
     case MP2::OBJ_OASIS:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isOasis);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isOasis);
         break;
 
     case MP2::OBJ_WATERINGHOLE:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isWateringHole);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isWateringHole);
         break;
 
     case MP2::OBJ_MINES:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isMine);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isMine);
         break;
 
     case MP2::OBJ_JAIL:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isJail);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isJail);
         break;
 
     case MP2::OBJ_EVENT:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isEvent);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isEvent);
         break;
 
     case MP2::OBJ_BOAT:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isBoat);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isBoat);
         break;
 
     case MP2::OBJ_BARRIER:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isBarrier);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isBarrier);
         break;
 
     case MP2::OBJ_HEROES:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isMiniHero);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isMiniHero);
         break;
 
     case MP2::OBJ_CASTLE:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isCastle);
-        if (it == addons_level1._items.end())
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isCastle);
+        if (it == addons_level1.end())
         {
-            it = find_if(addons_level2._items.begin(), addons_level2._items.end(), TilesAddon::isCastle);
-            return addons_level2._items.end() != it ? &*it : nullptr;
+            it = find_if(addons_level2.begin(), addons_level2.end(), TilesAddon::isCastle);
+            return addons_level2.end() != it ? &*it : nullptr;
         }
         break;
 
     case MP2::OBJ_RNDCASTLE:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isRandomCastle);
-        if (it == addons_level1._items.end())
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isRandomCastle);
+        if (it == addons_level1.end())
         {
-            it = find_if(addons_level2._items.begin(), addons_level2._items.end(), TilesAddon::isRandomCastle);
-            return addons_level2._items.end() != it ? &*it : nullptr;
+            it = find_if(addons_level2.begin(), addons_level2.end(), TilesAddon::isRandomCastle);
+            return addons_level2.end() != it ? &*it : nullptr;
         }
         break;
 
@@ -2110,11 +2343,11 @@ const Maps::TilesAddon* Maps::Tiles::FindObjectConst(int objs) const
     case MP2::OBJ_RNDMONSTER2:
     case MP2::OBJ_RNDMONSTER3:
     case MP2::OBJ_RNDMONSTER4:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isRandomMonster);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isRandomMonster);
         break;
 
     case MP2::OBJ_SKELETON:
-        it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isSkeleton);
+        it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isSkeleton);
         break;
 
     default:
@@ -2122,20 +2355,20 @@ const Maps::TilesAddon* Maps::Tiles::FindObjectConst(int objs) const
         break;
     }
 
-    return addons_level1._items.end() != it ? &*it : nullptr;
+    return addons_level1.end() != it ? &*it : nullptr;
 }
 
 Maps::TilesAddon* Maps::Tiles::FindFlags()
 {
-    auto it = find_if(addons_level1._items.begin(), addons_level1._items.end(), TilesAddon::isFlag32);
+    auto it = find_if(addons_level1.begin(), addons_level1.end(), TilesAddon::isFlag32);
 
-    if (it == addons_level1._items.end())
+    if (it == addons_level1.end())
     {
-        it = find_if(addons_level2._items.begin(), addons_level2._items.end(), TilesAddon::isFlag32);
-        return addons_level2._items.end() != it ? &*it : nullptr;
+        it = find_if(addons_level2.begin(), addons_level2.end(), TilesAddon::isFlag32);
+        return addons_level2.end() != it ? &*it : nullptr;
     }
 
-    return addons_level1._items.end() != it ? &*it : nullptr;
+    return addons_level1.end() != it ? &*it : nullptr;
 }
 
 /* ICN::FLAGS32 version */
@@ -2251,19 +2484,19 @@ void Maps::Tiles::CorrectFlags32(uint32_t index, bool up)
         taddon->index = index;
     else if (up)
         // or new flag
-        addons_level2._items.emplace_back(TilesAddon::UPPER, world.GetUniq(), 0x38, index);
+        addons_level2.emplace_back(TilesAddon::UPPER, world.GetUniq(), 0x38, index);
     else
         // or new flag
-        addons_level1._items.emplace_back(TilesAddon::UPPER, world.GetUniq(), 0x38, index);
+        addons_level1.emplace_back(TilesAddon::UPPER, world.GetUniq(), 0x38, index);
 }
 
 void Maps::Tiles::FixedPreload(Tiles& tile)
 {
     // fix skeleton: left position
-    auto it = find_if(tile.addons_level1._items.begin(), tile.addons_level1._items.end(),
+    auto it = find_if(tile.addons_level1.begin(), tile.addons_level1.end(),
                       TilesAddon::isSkeletonFix);
 
-    if (it != tile.addons_level1._items.end())
+    if (it != tile.addons_level1.end())
     {
         tile.SetObject(MP2::OBJN_SKELETON);
     }
@@ -2279,17 +2512,17 @@ void Maps::Tiles::FixedPreload(Tiles& tile)
     case MP2::OBJ_UNKNW_FA:
         {
             int newobj = MP2::OBJ_ZERO;
-            it = find_if(tile.addons_level1._items.begin(), tile.addons_level1._items.end(),
+            it = find_if(tile.addons_level1.begin(), tile.addons_level1.end(),
                          TilesAddon::isX_LOC123);
-            if (it != tile.addons_level1._items.end())
+            if (it != tile.addons_level1.end())
             {
                 newobj = TilesAddon::GetLoyaltyObject(*it);
             }
             else
             {
-                it = find_if(tile.addons_level2._items.begin(), tile.addons_level2._items.end(),
+                it = find_if(tile.addons_level2.begin(), tile.addons_level2.end(),
                              TilesAddon::isX_LOC123);
-                if (it != tile.addons_level2._items.end())
+                if (it != tile.addons_level2.end())
                     newobj = TilesAddon::GetLoyaltyObject(*it);
             }
 
@@ -2324,6 +2557,7 @@ bool Maps::Tiles::CaptureObjectIsProtection() const
 void Maps::Tiles::RemoveObjectSprite()
 {
     TilesAddon* addon = nullptr;
+    UpdateVersion();
 
     switch (GetObject())
     {
@@ -2341,11 +2575,11 @@ void Maps::Tiles::RemoveObjectSprite()
 
     case MP2::OBJ_JAIL:
         RemoveJailSprite();
-        tile_passable = DIRECTION_ALL;
+        tile_passable() = DIRECTION_ALL;
         break;
     case MP2::OBJ_BARRIER:
         RemoveBarrierSprite();
-        tile_passable = DIRECTION_ALL;
+        tile_passable() = DIRECTION_ALL;
         break;
 
     default:
@@ -2420,16 +2654,16 @@ void Maps::Tiles::RemoveJailSprite()
 
 void Maps::Tiles::UpdateAbandoneMineSprite(Tiles& tile)
 {
-    const auto it = find_if(tile.addons_level1._items.begin(), tile.addons_level1._items.end(),
+    const auto it = find_if(tile.addons_level1.begin(), tile.addons_level1.end(),
                             TilesAddon::isAbandoneMineSprite);
-    const uint32_t uniq = it != tile.addons_level1._items.end() ? (*it).uniq : 0;
+    const uint32_t uniq = it != tile.addons_level1.end() ? (*it).uniq : 0;
 
     Size wSize(world.w(), world.h());
     if (uniq)
     {
         const int type = tile.QuantityResourceCount().first;
 
-        for (auto& addonIt : tile.addons_level1._items)
+        for (auto& addonIt : tile.addons_level1)
             TilesAddon::UpdateAbandoneMineLeftSprite(addonIt, type);
 
         if (isValidDirection(tile.GetIndex(), Direction::RIGHT, wSize))
@@ -2537,31 +2771,32 @@ void Maps::Tiles::UpdateRNDResourceSprite(Tiles& tile)
 
 void Maps::Tiles::UpdateStoneLightsSprite(Tiles& tile)
 {
-    for (auto it = tile.addons_level1._items.begin(); it != tile.addons_level1._items.end(); ++it)
+    for (auto it = tile.addons_level1.begin(); it != tile.addons_level1.end(); ++it)
         tile.QuantitySetTeleportType(TilesAddon::UpdateStoneLightsSprite(*it));
 }
 
 void Maps::Tiles::UpdateFountainSprite(Tiles& tile)
 {
-    for (auto& it : tile.addons_level1._items)
+    for (auto& it : tile.addons_level1)
         TilesAddon::UpdateFountainSprite(it);
 }
 
 void Maps::Tiles::UpdateTreasureChestSprite(Tiles& tile)
 {
-    for (auto& it : tile.addons_level1._items)
+    for (auto& it : tile.addons_level1)
         TilesAddon::UpdateTreasureChestSprite(it);
 }
 
 bool Maps::Tiles::isFog(int colors) const
 {
     // colors may be the union friends
-    return (fog_colors & colors) == colors;
+    return world.vec_fog.isFog(maps_index, colors);
 }
 
 void Maps::Tiles::ClearFog(int colors)
 {
-    fog_colors &= ~colors;
+    if (world.vec_fog.ClearFog(maps_index, colors))
+        UpdateVersion();
 }
 
 void Maps::Tiles::RedrawFogs(Surface& dst, int color) const
@@ -2570,16 +2805,7 @@ void Maps::Tiles::RedrawFogs(Surface& dst, int color) const
     const Point mp = GetPoint(GetIndex());
 
     // get direction around foga
-    int around = 0;
-    const Directions& directions = Direction::All();
-
-    const Size wSize(world.w(), world.h());
-    for (int direction : directions)
-        if (!isValidDirection(GetIndex(), direction, wSize) ||
-            world.GetTiles(GetDirectionIndex(GetIndex(), direction)).isFog(color))
-            around |= direction;
-
-    if (isFog(color)) around |= Direction::CENTER;
+    const int around = world.vec_fog.GetAround(GetIndex(), color);
 
     // TIL::CLOF32
     if (DIRECTION_ALL == around)
@@ -2950,28 +3176,58 @@ ByteVectorWriter& Maps::operator<<(ByteVectorWriter& msg, const Tiles& tile)
 {
     return msg <<
         tile.maps_index <<
-        tile.pack_sprite_index <<
-        tile.tile_passable <<
-        tile.mp2_object <<
-        tile.fog_colors <<
-        tile.quantity1 <<
-        tile.quantity2 <<
-        tile.quantity3 <<
-        tile.addons_level1._items <<
-        tile.addons_level2._items;
+        tile.pack_sprite_index() <<
+        tile.tile_passable() <<
+        tile.mp2_object() <<
+        static_cast<u8>(world.vec_fog.Get(tile.maps_index)) <<
+        tile.quantity1() <<
+        tile.quantity2() <<
+        tile.quantity3() <<
+        tile.addons_level1 <<
+        tile.addons_level2;
+}
+
+ByteVectorWriter& Maps::operator<<(ByteVectorWriter& msg, const Addons& addons)
+{
+    // same layout as the vector of addons
+    msg.put32(addons.size());
+    for (const TilesAddon& addon : addons)
+        msg << addon;
+    return msg;
+}
+
+ByteVectorReader& Maps::operator>>(ByteVectorReader& msg, Addons& addons)
+{
+    const uint32_t size = msg.get32();
+
+    addons.clear();
+    addons.reserve(size);
+    for (uint32_t ii = 0; ii < size; ++ii)
+    {
+        TilesAddon addon;
+        msg >> addon;
+        addons.push_back(addon);
+    }
+    return msg;
 }
 
 ByteVectorReader& Maps::operator>>(ByteVectorReader& msg, Tiles& tile)
 {
+    ++tiles_version;
+    u8 fog = 0;
+    // the index first: it selects the fields in the world layer
+    msg >> tile.maps_index;
+    msg >>
+        tile.pack_sprite_index() >>
+        tile.tile_passable() >>
+        tile.mp2_object() >>
+        fog;
+    // the fog lives in the world layer, see World loading
+    world.vec_fog.Set(tile.maps_index, fog);
     return msg >>
-        tile.maps_index >>
-        tile.pack_sprite_index >>
-        tile.tile_passable >>
-        tile.mp2_object >>
-        tile.fog_colors >>
-        tile.quantity1 >>
-        tile.quantity2 >>
-        tile.quantity3 >>
-        tile.addons_level1._items >>
-        tile.addons_level2._items;
+        tile.quantity1() >>
+        tile.quantity2() >>
+        tile.quantity3() >>
+        tile.addons_level1 >>
+        tile.addons_level2;
 }
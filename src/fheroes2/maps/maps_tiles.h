@@ -22,6 +22,9 @@
 
 #pragma once
 
+#include <iterator>
+#include <utility>
+
 #include "direction.h"
 #include "skill.h"
 #include "artifact.h"
@@ -46,6 +49,8 @@ namespace MP2
 
 namespace Maps
 {
+    class AddonArena;
+
     struct TilesAddon
     {
         enum level_t
@@ -60,6 +65,8 @@ namespace Maps
 
         TilesAddon(int lv, uint32_t gid, int obj, uint32_t ii);
 
+        TilesAddon(const TilesAddon&) = default;
+
         TilesAddon& operator=(const TilesAddon& ta);
 
         bool isUniq(uint32_t) const;
@@ -188,10 +195,105 @@ namespace Maps
         u8 tmp;
     };
 
-    struct Addons
+    /* addons of one tile level: a range of the shared addon arena instead of a heap vector per tile */
+    class Addons
     {
-        vector<TilesAddon> _items;
+    public:
+        typedef TilesAddon* iterator;
+        typedef const TilesAddon* const_iterator;
+        typedef std::reverse_iterator<iterator> reverse_iterator;
+        typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        Addons() = default;
+
+        Addons(const Addons&);
+
+        Addons(Addons&&) noexcept;
+
+        ~Addons();
+
+        Addons& operator=(const Addons&);
+
+        Addons& operator=(Addons&&) noexcept;
+
+        iterator begin()
+        {
+            return items;
+        }
+
+        iterator end()
+        {
+            return items + count;
+        }
+
+        const_iterator begin() const
+        {
+            return items;
+        }
+
+        const_iterator end() const
+        {
+            return items + count;
+        }
+
+        reverse_iterator rbegin()
+        {
+            return reverse_iterator(end());
+        }
+
+        reverse_iterator rend()
+        {
+            return reverse_iterator(begin());
+        }
+
+        bool empty() const
+        {
+            return 0 == count;
+        }
+
+        uint32_t size() const
+        {
+            return count;
+        }
+
+        void push_back(const TilesAddon&);
+
+        template <class... Args>
+        void emplace_back(Args&&... args)
+        {
+            push_back(TilesAddon(std::forward<Args>(args)...));
+        }
+
+        void clear();
+
+        void reserve(uint32_t);
+
         void Remove(uint32_t uniq);
+
+        /* addons, reserved slots and bytes of the arena */
+        static string ArenaInfo();
+
+    private:
+        TilesAddon* items = nullptr;
+        u16 count = 0;
+        u16 capacity = 0;
+    };
+
+    /* addons of the tiles made and destroyed in its scope come from a private arena, freed with it */
+    class ScopedAddonArena
+    {
+    public:
+        ScopedAddonArena();
+
+        ScopedAddonArena(const ScopedAddonArena&) = delete;
+
+        ~ScopedAddonArena();
+
+        ScopedAddonArena& operator=(const ScopedAddonArena&) = delete;
+
+    private:
+        AddonArena* arena;
+        AddonArena* saved;
     };
 
     class Tiles
@@ -209,15 +311,9 @@ namespace Maps
 
         uint32_t GetObjectUID(int obj) const;
 
-        int GetQuantity1() const
-        {
-            return quantity1;
-        }
+        int GetQuantity1() const;
 
-        int GetQuantity2() const
-        {
-            return quantity2;
-        }
+        int GetQuantity2() const;
 
         int GetPassable() const;
 
@@ -233,14 +329,13 @@ namespace Maps
 
         bool isPassable(const Heroes&) const;
 
+        bool isPassable(bool shipMaster) const;
+
         bool isPassable(const Heroes*, int direct, bool skipfog) const;
 
         bool isRoad(int = DIRECTION_ALL) const;
 
-        bool isObject(int obj) const
-        {
-            return obj == mp2_object;
-        }
+        bool isObject(int obj) const;
 
         bool isStream() const;
 
@@ -285,6 +380,7 @@ namespace Maps
         void RedrawFogs(Surface&, int) const;
 
         static void RedrawPassable(Surface&);
+        void PrefetchSprites() const;
 
         void AddonsPushLevel1(const MP2::mp2tile_t&);
 
@@ -378,6 +474,14 @@ namespace Maps
 
         static void FixedPreload(Tiles&);
 
+        /* changes with any object, hero or fog update on the map */
+        static uint32_t GetVersion();
+
+        /* back to a version saved before a detached load, see World::TilesBenchmark */
+        static void RestoreVersion(uint32_t);
+
+        void UpdateVersion();
+
     private:
         TilesAddon* FindFlags();
 
@@ -427,6 +531,31 @@ namespace Maps
 
         static void UpdateTreasureChestSprite(Tiles&);
 
+        /* hot fields in world.vec_hot by maps_index, inline in world.h */
+        u8& mp2_object();
+
+        u8 mp2_object() const;
+
+        u16& tile_passable();
+
+        u16 tile_passable() const;
+
+        u16& pack_sprite_index();
+
+        u16 pack_sprite_index() const;
+
+        u8& quantity1();
+
+        u8 quantity1() const;
+
+        u8& quantity2();
+
+        u8 quantity2() const;
+
+        u8& quantity3();
+
+        u8 quantity3() const;
+
         friend ByteVectorWriter& operator<<(ByteVectorWriter&, const Tiles&);
 
         friend ByteVectorReader& operator>>(ByteVectorReader&, Tiles&);
@@ -435,20 +564,13 @@ namespace Maps
         Addons addons_level2; // 16
 
         uint32_t maps_index = 0;
-        u16 pack_sprite_index = 0;
-
-        u16 tile_passable = 0;
-        u8 mp2_object = 0;
-        u8 fog_colors = 0;
-
-        u8 quantity1 = 0;
-        u8 quantity2 = 0;
-        u8 quantity3 = 0;
     };
 
     ByteVectorWriter& operator<<(ByteVectorWriter&, const TilesAddon&);
+    ByteVectorWriter& operator<<(ByteVectorWriter&, const Addons&);
     ByteVectorWriter& operator<<(ByteVectorWriter&, const Tiles&);
 
     ByteVectorReader& operator>>(ByteVectorReader&, TilesAddon&);
+    ByteVectorReader& operator>>(ByteVectorReader&, Addons&);
     ByteVectorReader& operator>>(ByteVectorReader&, Tiles&);
 }
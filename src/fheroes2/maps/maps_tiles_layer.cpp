@@ -0,0 +1,58 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "maps_tiles_layer.h"
+#include "direction.h"
+
+void Maps::TilesLayer::Reset(s32 size)
+{
+    objects.assign(size, 0);
+    passable.assign(size, DIRECTION_ALL);
+    sprites.assign(size, 0);
+    quantity1.assign(size, 0);
+    quantity2.assign(size, 0);
+    quantity3.assign(size, 0);
+}
+
+void Maps::TilesLayer::Clear()
+{
+    objects.clear();
+    passable.clear();
+    sprites.clear();
+    quantity1.clear();
+    quantity2.clear();
+    quantity3.clear();
+}
+
+void Maps::TilesLayer::Swap(TilesLayer& other)
+{
+    objects.swap(other.objects);
+    passable.swap(other.passable);
+    sprites.swap(other.sprites);
+    quantity1.swap(other.quantity1);
+    quantity2.swap(other.quantity2);
+    quantity3.swap(other.quantity3);
+}
+
+size_t Maps::TilesLayer::Bytes() const
+{
+    return objects.capacity() + passable.capacity() * sizeof(u16) + sprites.capacity() * sizeof(u16) +
+        quantity1.capacity() + quantity2.capacity() + quantity3.capacity();
+}
@@ -0,0 +1,48 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include "types.h"
+
+namespace Maps
+{
+    /* hot fields of all world tiles as contiguous arrays by the tile index, the fog is in FogLayer */
+    class TilesLayer
+    {
+    public:
+        /* size the arrays, all tiles as new ones */
+        void Reset(s32 size);
+
+        void Clear();
+
+        void Swap(TilesLayer&);
+
+        size_t Bytes() const;
+
+        std::vector<u8> objects;
+        std::vector<u16> passable;
+        std::vector<u16> sprites; // packed sprite index and shape
+        std::vector<u8> quantity1;
+        std::vector<u8> quantity2;
+        std::vector<u8> quantity3;
+    };
+}
@@ -54,13 +54,13 @@ bool Maps::Tiles::QuantityIsValid() const
     case MP2::OBJ_WINDMILL:
     case MP2::OBJ_LEANTO:
     case MP2::OBJ_MAGICGARDEN:
-        return quantity2;
+        return quantity2();
 
     case MP2::OBJ_SKELETON:
         return QuantityArtifact() != Artifact::UNKNOWN;
 
     case MP2::OBJ_WAGON:
-        return QuantityArtifact() != Artifact::UNKNOWN || quantity2;
+        return QuantityArtifact() != Artifact::UNKNOWN || quantity2();
 
     case MP2::OBJ_DAEMONCAVE:
         return QuantityVariant();
@@ -74,24 +74,24 @@ bool Maps::Tiles::QuantityIsValid() const
 
 int Maps::Tiles::QuantityVariant() const
 {
-    return quantity2 >> 4;
+    return quantity2() >> 4;
 }
 
 int Maps::Tiles::QuantityExt() const
 {
-    return 0x0f & quantity2;
+    return 0x0f & quantity2();
 }
 
 void Maps::Tiles::QuantitySetVariant(int variant)
 {
-    quantity2 &= 0x0f;
-    quantity2 |= variant << 4;
+    quantity2() &= 0x0f;
+    quantity2() |= variant << 4;
 }
 
 void Maps::Tiles::QuantitySetExt(int ext)
 {
-    quantity2 &= 0xf0;
-    quantity2 |= 0x0f & ext;
+    quantity2() &= 0xf0;
+    quantity2() |= 0x0f & ext;
 }
 
 Skill::Secondary Maps::Tiles::QuantitySkill() const
@@ -111,7 +111,7 @@ Skill::Secondary Maps::Tiles::QuantitySkill() const
         break;
 
     case MP2::OBJ_WITCHSHUT:
-        return {(Skill::SkillT)quantity1, Skill::Level::BASIC};
+        return {(Skill::SkillT)quantity1(), Skill::Level::BASIC};
 
     default:
         break;
@@ -125,7 +125,7 @@ void Maps::Tiles::QuantitySetSkill(Skill::SkillT skill)
     switch (GetObject(false))
     {
     case MP2::OBJ_WITCHSHUT:
-        quantity1 = (u8)skill;
+        quantity1() = (u8)skill;
         break;
 
     default:
@@ -138,13 +138,13 @@ Spell Maps::Tiles::QuantitySpell() const
     switch (GetObject(false))
     {
     case MP2::OBJ_ARTIFACT:
-        return {QuantityVariant() == 15 ? quantity1 : Spell::NONE};
+        return {QuantityVariant() == 15 ? quantity1() : Spell::NONE};
 
     case MP2::OBJ_SHRINE1:
     case MP2::OBJ_SHRINE2:
     case MP2::OBJ_SHRINE3:
     case MP2::OBJ_PYRAMID:
-        return {quantity1};
+        return {quantity1()};
 
     default:
         break;
@@ -162,7 +162,7 @@ void Maps::Tiles::QuantitySetSpell(int spell)
     case MP2::OBJ_SHRINE2:
     case MP2::OBJ_SHRINE3:
     case MP2::OBJ_PYRAMID:
-        quantity1 = spell;
+        quantity1() = spell;
         break;
 
     default:
@@ -175,7 +175,7 @@ Artifact Maps::Tiles::QuantityArtifact() const
     switch (GetObject(false))
     {
     case MP2::OBJ_WAGON:
-        return {quantity2 ? Artifact::UNKNOWN : quantity1};
+        return {quantity2() ? Artifact::UNKNOWN : quantity1()};
 
     case MP2::OBJ_SKELETON:
     case MP2::OBJ_DAEMONCAVE:
@@ -184,7 +184,7 @@ Artifact Maps::Tiles::QuantityArtifact() const
     case MP2::OBJ_SHIPWRECKSURVIROR:
     case MP2::OBJ_SHIPWRECK:
     case MP2::OBJ_GRAVEYARD:
-        return {quantity1};
+        return {quantity1()};
 
     case MP2::OBJ_ARTIFACT:
         {
@@ -194,7 +194,7 @@ Artifact Maps::Tiles::QuantityArtifact() const
                 art.SetSpell(QuantitySpell().GetID());
                 return art;
             }
-            return {quantity1};
+            return {quantity1()};
         }
 
     default:
@@ -206,13 +206,13 @@ Artifact Maps::Tiles::QuantityArtifact() const
 
 void Maps::Tiles::QuantitySetArtifact(int art)
 {
-    quantity1 = art;
+    quantity1() = art;
 }
 
 void Maps::Tiles::QuantitySetResource(int res, uint32_t count)
 {
-    quantity1 = res;
-    quantity2 = res == Resource::GOLD ? count / 100 : count;
+    quantity1() = res;
+    quantity2() = res == Resource::GOLD ? count / 100 : count;
 }
 
 uint32_t Maps::Tiles::QuantityGold() const
@@ -240,7 +240,7 @@ uint32_t Maps::Tiles::QuantityGold() const
     case MP2::OBJ_MAGICGARDEN:
     case MP2::OBJ_WATERWHEEL:
     case MP2::OBJ_TREEKNOWLEDGE:
-        return quantity1 == Resource::GOLD ? 100 * quantity2 : 0;
+        return quantity1() == Resource::GOLD ? 100 * quantity2() : 0;
 
     case MP2::OBJ_FLOTSAM:
     case MP2::OBJ_CAMPFIRE:
@@ -248,7 +248,7 @@ uint32_t Maps::Tiles::QuantityGold() const
     case MP2::OBJ_TREASURECHEST:
     case MP2::OBJ_DERELICTSHIP:
     case MP2::OBJ_GRAVEYARD:
-        return 100 * quantity2;
+        return 100 * quantity2();
 
     case MP2::OBJ_DAEMONCAVE:
         switch (QuantityVariant())
@@ -305,13 +305,13 @@ ResourceCount Maps::Tiles::QuantityResourceCount() const
         return ResourceCount(Resource::GOLD, QuantityGold());
 
     case MP2::OBJ_FLOTSAM:
-        return ResourceCount(Resource::WOOD, quantity1);
+        return ResourceCount(Resource::WOOD, quantity1());
 
     default:
         break;
     }
 
-    return ResourceCount(quantity1, Resource::GOLD == quantity1 ? QuantityGold() : quantity2);
+    return ResourceCount(quantity1(), Resource::GOLD == quantity1() ? QuantityGold() : quantity2());
 }
 
 Funds Maps::Tiles::QuantityFunds() const
@@ -337,7 +337,7 @@ Funds Maps::Tiles::QuantityFunds() const
         return Funds(Resource::GOLD, QuantityGold()) + Funds(rc);
 
     case MP2::OBJ_FLOTSAM:
-        return Funds(Resource::GOLD, QuantityGold()) + Funds(Resource::WOOD, quantity1);
+        return Funds(Resource::GOLD, QuantityGold()) + Funds(Resource::WOOD, quantity1());
 
     case MP2::OBJ_WATERCHEST:
     case MP2::OBJ_TREASURECHEST:
@@ -360,7 +360,7 @@ void Maps::Tiles::QuantitySetColor(int col)
     {
     case MP2::OBJ_BARRIER:
     case MP2::OBJ_TRAVELLERTENT:
-        quantity1 = col;
+        quantity1() = col;
         break;
 
     default:
@@ -375,7 +375,7 @@ int Maps::Tiles::QuantityColor() const
     {
     case MP2::OBJ_BARRIER:
     case MP2::OBJ_TRAVELLERTENT:
-        return quantity1;
+        return quantity1();
 
     default:
         return world.ColorCapturedObject(GetIndex());
@@ -386,12 +386,12 @@ int Maps::Tiles::QuantityColor() const
 
 int Maps::Tiles::QuantityTeleportType() const
 {
-    return quantity1;
+    return quantity1();
 }
 
 void Maps::Tiles::QuantitySetTeleportType(int type)
 {
-    quantity1 = type;
+    quantity1() = type;
 }
 
 Monster Maps::Tiles::QuantityMonster() const
@@ -470,8 +470,8 @@ Troop Maps::Tiles::QuantityTroop() const
 
 void Maps::Tiles::QuantityReset()
 {
-    quantity1 = 0;
-    quantity2 = 0;
+    quantity1() = 0;
+    quantity2() = 0;
 
     switch (GetObject(false))
     {
@@ -491,7 +491,7 @@ void Maps::Tiles::QuantityReset()
         break;
     }
 
-    if (MP2::isPickupObject(mp2_object))
+    if (MP2::isPickupObject(mp2_object()))
         SetObject(MP2::OBJ_ZERO);
 }
 
@@ -532,7 +532,7 @@ void Maps::Tiles::QuantityUpdate()
 
     case MP2::OBJ_WAGON:
         {
-            quantity2 = 0;
+            quantity2() = 0;
 
             Rand::Queue percents(3);
             // 20%: empty
@@ -570,7 +570,7 @@ void Maps::Tiles::QuantityUpdate()
                     {
                         QuantitySetVariant(15);
                         // spell from origin mp2
-                        QuantitySetSpell(1 + (quantity2 * 256 + quantity1) / 8);
+                        QuantitySetSpell(1 + (quantity2() * 256 + quantity1()) / 8);
                     }
                     else
                     {
@@ -669,16 +669,16 @@ void Maps::Tiles::QuantityUpdate()
                 // 25%: 500 gold + 10 wood
             case 1:
                 QuantitySetResource(Resource::GOLD, 500);
-                quantity1 = 10;
+                quantity1() = 10;
                 break;
                 // 25%: 200 gold + 5 wood
             case 2:
                 QuantitySetResource(Resource::GOLD, 200);
-                quantity1 = 5;
+                quantity1() = 5;
                 break;
                 // 25%: 5 wood
             case 3:
-                quantity1 = 5;
+                quantity1() = 5;
                 break;
             }
         }
@@ -850,18 +850,18 @@ void Maps::Tiles::QuantityUpdate()
 
     case MP2::OBJ_BARRIER:
         {
-            const auto it = find_if(addons_level1._items.rbegin(), addons_level1._items.rend(),
+            const auto it = find_if(addons_level1.rbegin(), addons_level1.rend(),
                                     [](TilesAddon& it) { return TilesAddon::ColorFromBarrierSprite(it); });
-            if (it != addons_level1._items.rend())
+            if (it != addons_level1.rend())
                 QuantitySetColor(TilesAddon::ColorFromBarrierSprite(*it));
         }
         break;
 
     case MP2::OBJ_TRAVELLERTENT:
         {
-            auto it = find_if(addons_level1._items.rbegin(), addons_level1._items.rend(),
+            auto it = find_if(addons_level1.rbegin(), addons_level1.rend(),
                               [](TilesAddon& it) { return TilesAddon::ColorFromTravellerTentSprite(it); });
-            if (it != addons_level1._items.rend())
+            if (it != addons_level1.rend())
                 QuantitySetColor(TilesAddon::ColorFromTravellerTentSprite(*it));
         }
         break;
@@ -1076,13 +1076,13 @@ bool Maps::Tiles::MonsterJoinConditionForce() const
 
 uint32_t Maps::Tiles::MonsterCount() const
 {
-    return static_cast<uint32_t>(quantity1) << 8 | quantity2;
+    return static_cast<uint32_t>(quantity1()) << 8 | quantity2();
 }
 
 void Maps::Tiles::MonsterSetCount(uint32_t count)
 {
-    quantity1 = count >> 8;
-    quantity2 = 0x00FF & count;
+    quantity1() = count >> 8;
+    quantity2() = 0x00FF & count;
 }
 
 void Maps::Tiles::PlaceMonsterOnTile(Tiles& tile, const Monster& mons, uint32_t count)
@@ -1205,11 +1205,11 @@ void Maps::Tiles::UpdateMonsterInfo(Tiles& tile)
     uint32_t count = 0;
 
     // update count (mp2 format)
-    if (tile.quantity1 || tile.quantity2)
+    if (tile.quantity1() || tile.quantity2())
     {
-        count = tile.quantity2;
+        count = tile.quantity2();
         count <<= 8;
-        count |= tile.quantity1;
+        count |= tile.quantity1();
         count >>= 3;
     }
 
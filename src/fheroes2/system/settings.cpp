@@ -203,6 +203,7 @@ const settings_t settingsFHeroes2[] =
     {Settings::BATTLE_MAGIC_TROOP_RESIST, _("battle: magical creature resists (20%) the same magic"),},
     {Settings::BATTLE_SKIP_INCREASE_DEFENSE, _("battle: skip increase +2 defense"),},
     {Settings::BATTLE_REVERSE_WAIT_ORDER, _("battle: reverse wait order (fast, average, slow)"),},
+    {Settings::BATTLE_AI_ESTIMATE_OUTCOME, _("battle: AI estimates close fights by simulated battles"),},
     {Settings::GAME_SHOW_SYSTEM_INFO, _("game: show system info"),},
     {Settings::GAME_AUTOSAVE_ON, _("game: autosave on"),},
     {Settings::GAME_AUTOSAVE_BEGIN_DAY, _("game: autosave will be made at the beginning of the day"),},
@@ -820,6 +821,16 @@ bool Settings::QuickCombat() const
     return _isQuickCombat;
 }
 
+void Settings::SetHeadless(bool value)
+{
+    _isHeadless = value;
+}
+
+bool Settings::Headless() const
+{
+    return _isHeadless;
+}
+
 bool Settings::UiHeroesBar() const
 {
     return _isUiHeroesBar;
@@ -1399,6 +1410,11 @@ bool Settings::ExtBattleSkipIncreaseDefense() const
     return ExtModes(BATTLE_SKIP_INCREASE_DEFENSE);
 }
 
+bool Settings::ExtBattleAIEstimateOutcome() const
+{
+    return ExtModes(BATTLE_AI_ESTIMATE_OUTCOME);
+}
+
 bool Settings::ExtHeroAllowTranscribingScroll() const
 {
     return ExtModes(HEROES_TRANSCRIBING_SCROLLS);
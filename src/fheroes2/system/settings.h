@@ -29,9 +29,10 @@
 #include "bitmodes.h"
 #include "ByteVectorWriter.h"
 
+#define FORMAT_VERSION_3270 3270
 #define FORMAT_VERSION_3269 3269
 #define FORMAT_VERSION_3255 3255
-#define CURRENT_FORMAT_VERSION FORMAT_VERSION_3269
+#define CURRENT_FORMAT_VERSION FORMAT_VERSION_3270
 #define LAST_FORMAT_VERSION FORMAT_VERSION_3255
 
 enum
@@ -165,7 +166,7 @@ public:
 
         BATTLE_ARCHMAGE_RESIST_BAD_SPELL = 0x40001000,
         BATTLE_MAGIC_TROOP_RESIST = 0x40002000,
-        //UNUSED			= 0x40008000,
+        BATTLE_AI_ESTIMATE_OUTCOME = 0x40008000,
         BATTLE_SOFT_WAITING = 0x40010000,
         BATTLE_REVERSE_WAIT_ORDER = 0x40020000,
         BATTLE_MERGE_ARMIES = 0x40100000,
@@ -247,6 +248,11 @@ public:
     void SetQuickCombat(bool value);
 
     bool QuickCombat() const;
+
+    /* no video, audio or event pumping: the game simulator runs all kingdoms as AI */
+    void SetHeadless(bool value);
+
+    bool Headless() const;
     bool UiHeroesBar() const;
 
     bool ShowControlPanel() const;
@@ -391,6 +397,8 @@ public:
 
     bool ExtBattleSkipIncreaseDefense() const;
 
+    bool ExtBattleAIEstimateOutcome() const;
+
     bool ExtBattleReverseWaitOrder() const;
 
     bool ExtBattleShowGrid() const;
@@ -603,6 +611,7 @@ private:
     int size_small;
 
     bool _isQuickCombat{};
+    bool _isHeadless{};
     bool _isUiHeroesBar{};
 
 
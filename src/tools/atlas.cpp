@@ -0,0 +1,79 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <iostream>
+
+#include "system.h"
+#include "thread.h"
+#include "settings.h"
+#include "agg.h"
+
+std::vector<std::string> extractArgsVector(int argc, char** argv);
+
+int PrintHelp(const char* basename)
+{
+    COUT("Usage: " << basename << " [OPTIONS]");
+    COUT("  -c file\tread game settings from the config file");
+    COUT("  -h\tprint this help and exit");
+    COUT("");
+    COUT("writes heroes2.atl next to heroes2.agg, the game loads sprites from it without decoding");
+    COUT("rebuild it after replacing heroes2.agg or heroes2x.agg, an outdated atlas is ignored");
+
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+    const vector<string> vArgv = extractArgsVector(argc, argv);
+
+    Settings& conf = Settings::Get();
+    conf.SetProgramPath(vArgv[0]);
+
+    for (size_t ii = 1; ii < vArgv.size(); ++ii)
+    {
+        const string& arg = vArgv[ii];
+
+        if ("-h" == arg)
+            return PrintHelp(vArgv[0].c_str());
+        if ("-c" == arg && ii + 1 < vArgv.size())
+            conf.Read(vArgv[++ii]);
+        else
+        {
+            PrintHelp(vArgv[0].c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    SDL::Time time;
+    time.Start();
+    const string file = AGG::WriteAtlas();
+    time.Stop();
+
+    if (file.empty())
+    {
+        H2ERROR("heroes2.agg not found");
+        return EXIT_FAILURE;
+    }
+
+    COUT("atlas: " << file << ", time: " << time.Get() << " ms");
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,133 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <iostream>
+
+#include "engine.h"
+#include "system.h"
+#include "tools.h"
+#include "rand.h"
+#include "thread.h"
+#include "settings.h"
+#include "race.h"
+#include "battle_simulator.h"
+
+std::vector<std::string> extractArgsVector(int argc, char** argv);
+
+int PrintHelp(const char* basename)
+{
+    COUT("Usage: " << basename << " [OPTIONS] ATTACKER DEFENDER");
+    COUT("  -n count\tnumber of battles, default 100");
+    COUT("  -s seed\trandom seed, default current time");
+    COUT("  -t race\tdefender holds a castle of the race");
+    COUT("  -c file\tread game settings from the config file");
+    COUT("  -e\tplay one setup on all cores with the outcome estimator");
+    COUT("  -h\tprint this help and exit");
+    COUT("");
+    COUT("army: [hero=race[/attack/defense/power/knowledge],]monster:count[,monster:count...]");
+    COUT("example: " << basename << " hero=knight/2/2/1/1,swordsman:20,archer:15 ogre:30,goblin:80");
+    COUT("the attacker always needs a hero");
+
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+    const vector<string> vArgv = extractArgsVector(argc, argv);
+    vector<string> armies;
+    Battle::Simulator simulator;
+    uint32_t count = 100;
+    uint32_t seed = 0;
+    bool estimate = false;
+
+    Settings& conf = Settings::Get();
+    conf.SetProgramPath(vArgv[0]);
+
+    for (size_t ii = 1; ii < vArgv.size(); ++ii)
+    {
+        const string& arg = vArgv[ii];
+        const bool value = ii + 1 < vArgv.size();
+
+        if ("-h" == arg)
+            return PrintHelp(vArgv[0].c_str());
+        if ("-n" == arg && value)
+            count = GetInt(vArgv[++ii]);
+        else if ("-s" == arg && value)
+            seed = GetInt(vArgv[++ii]);
+        else if ("-t" == arg && value)
+        {
+            const string race = StringLower(vArgv[++ii]);
+
+            for (int it = Race::KNGT; it <= Race::NECR; it <<= 1)
+                if (StringLower(Race::String(it)) == race) simulator.castle = it;
+            if (Race::NONE == simulator.castle)
+            {
+                H2ERROR("unknown castle race: " << race);
+                return EXIT_FAILURE;
+            }
+        }
+        else if ("-c" == arg && value)
+            conf.Read(vArgv[++ii]);
+        else if ("-e" == arg)
+            estimate = true;
+        else
+            armies.push_back(arg);
+    }
+
+    if (2 != armies.size())
+    {
+        PrintHelp(vArgv[0].c_str());
+        return EXIT_FAILURE;
+    }
+
+    if (!simulator.attacker.Parse(armies[0]) || Race::NONE == simulator.attacker.race ||
+        !simulator.defender.Parse(armies[1]))
+    {
+        H2ERROR("invalid army");
+        return EXIT_FAILURE;
+    }
+
+    Rand::Init(seed);
+
+    // timer only: no video, audio or game data
+    if (!SDL::Init(INIT_TIMER))
+        return EXIT_FAILURE;
+
+    atexit(SDL::Quit);
+
+    COUT("attacker: " << simulator.attacker.String());
+    COUT("defender: " << simulator.defender.String() <<
+        (Race::NONE != simulator.castle ? " in " + Race::String(simulator.castle) + " castle" : ""));
+
+    if (estimate)
+    {
+        SDL::Time time;
+        time.Start();
+        const Battle::Estimate result = simulator.RunEstimate(count);
+        time.Stop();
+
+        COUT(result.String() << ", threads: " << Battle::EstimateThreads() << ", time: " << time.Get() << " ms");
+    }
+    else
+        COUT(simulator.Run(count).String());
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+/***************************************************************************
+ *   Part of the Free Heroes2 Engine:                                      *
+ *   http://sourceforge.net/projects/fheroes2                              *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <iostream>
+
+#include "engine.h"
+#include "system.h"
+#include "tools.h"
+#include "rand.h"
+#include "settings.h"
+#include "profiler.h"
+#include "game_simulator.h"
+
+std::vector<std::string> extractArgsVector(int argc, char** argv);
+
+int PrintHelp(const char* basename)
+{
+    COUT("Usage: " << basename << " [OPTIONS] MAP");
+    COUT("  -d days\tnumber of days, default 28");
+    COUT("  -s seed\trandom seed, default current time");
+    COUT("  -c file\tread game settings from the config file");
+    COUT("  -p file\tprofile every day and kingdom turn into the file, csv for *.csv names, text otherwise");
+    COUT("  -h\tprint this help and exit");
+    COUT("");
+    COUT("plays the mp2/mx2 map with all kingdoms under AI control, prints the time of every day and the final state");
+    COUT("the game ends early when one kingdom is left or wins");
+
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+    const vector<string> vArgv = extractArgsVector(argc, argv);
+    Game::Simulator simulator;
+    string map;
+    string profile;
+    uint32_t days = 28;
+    uint32_t seed = 0;
+
+    Settings& conf = Settings::Get();
+    conf.SetProgramPath(vArgv[0]);
+
+    for (size_t ii = 1; ii < vArgv.size(); ++ii)
+    {
+        const string& arg = vArgv[ii];
+        const bool value = ii + 1 < vArgv.size();
+
+        if ("-h" == arg)
+            return PrintHelp(vArgv[0].c_str());
+        if ("-d" == arg && value)
+            days = GetInt(vArgv[++ii]);
+        else if ("-s" == arg && value)
+            seed = GetInt(vArgv[++ii]);
+        else if ("-c" == arg && value)
+            conf.Read(vArgv[++ii]);
+        else if ("-p" == arg && value)
+            profile = vArgv[++ii];
+        else
+            map = arg;
+    }
+
+    if (map.empty())
+    {
+        PrintHelp(vArgv[0].c_str());
+        return EXIT_FAILURE;
+    }
+
+    Rand::Init(seed);
+
+    // timer only: no video, audio or game data
+    if (!SDL::Init(INIT_TIMER))
+        return EXIT_FAILURE;
+
+    atexit(SDL::Quit);
+
+    if (!simulator.Load(map))
+        return EXIT_FAILURE;
+
+    COUT("map: " << map << ", seed: " << Rand::GetSeed());
+
+    if (!profile.empty())
+    {
+        Profiler::SetEnabled(true);
+        Profiler::SetOutput(profile);
+    }
+
+    SDL::Time time;
+    time.Start();
+
+    for (uint32_t day = 0; day < days && !simulator.isGameOver(); ++day)
+        COUT(simulator.RunDay().String());
+
+    time.Stop();
+
+    COUT(Game::Simulator::State() << "time: " << time.Get() << " ms");
+
+    return EXIT_SUCCESS;
+}